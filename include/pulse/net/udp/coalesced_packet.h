@@ -0,0 +1,63 @@
+#pragma once
+
+#include "endpoint.h"
+#include <cstdint>
+#include <cstddef>
+#include <span>
+
+namespace pulse::net::udp {
+
+// Largest buffer recvCoalesced() can return: one full UDP GRO super-packet
+inline constexpr size_t kMaxCoalescedBytes = 65535;
+
+// One receive that may hold several datagrams merged by UDP GRO.
+// All datagrams come from `addr` and are `segmentSize` bytes long, except possibly the last one.
+// Iterate segments() to walk them in place without copying.
+struct CoalescedPacket {
+    const uint8_t* data;
+    size_t length;
+    size_t segmentSize; // equals `length` when the kernel delivered a single datagram
+    Endpoint addr;
+
+    class SegmentIterator {
+    public:
+        SegmentIterator(const uint8_t* cursor, const uint8_t* end, size_t segmentSize)
+            : cursor_(cursor), end_(end), segment_size_(segmentSize) {}
+
+        std::span<const uint8_t> operator*() const {
+            const size_t remaining = static_cast<size_t>(end_ - cursor_);
+            return {cursor_, remaining < segment_size_ ? remaining : segment_size_};
+        }
+
+        SegmentIterator& operator++() {
+            const size_t remaining = static_cast<size_t>(end_ - cursor_);
+            cursor_ += remaining < segment_size_ ? remaining : segment_size_;
+            return *this;
+        }
+
+        bool operator==(const SegmentIterator& other) const { return cursor_ == other.cursor_; }
+
+    private:
+        const uint8_t* cursor_;
+        const uint8_t* end_;
+        size_t segment_size_;
+    };
+
+    struct SegmentRange {
+        SegmentIterator first;
+        SegmentIterator last;
+        SegmentIterator begin() const { return first; }
+        SegmentIterator end() const { return last; }
+    };
+
+    size_t segmentCount() const {
+        return segmentSize == 0 ? 0 : (length + segmentSize - 1) / segmentSize;
+    }
+
+    SegmentRange segments() const {
+        const uint8_t* end = (segmentSize == 0) ? data : data + length;
+        return {SegmentIterator{data, end, segmentSize}, SegmentIterator{end, end, segmentSize}};
+    }
+};
+
+} // namespace pulse::net::udp
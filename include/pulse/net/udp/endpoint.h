@@ -0,0 +1,85 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+namespace pulse::net::udp {
+
+class Addr;
+
+// Compact binary endpoint: raw IPv4/IPv6 address bytes, IPv6 scope id and port, 24 bytes, trivially copyable.
+// This is what the receive path hands back, so no per-datagram formatting or allocation happens.
+// Text is produced on demand through ip() / toString().
+class Endpoint {
+public:
+    enum class Family : uint8_t {
+        Unspecified = 0,
+        IPv4 = 4,
+        IPv6 = 6
+    };
+
+    Endpoint() = default;
+
+    static Endpoint FromAddr(const Addr& addr);
+
+    // Decodes a sockaddr_in / sockaddr_in6, keeping sin6_scope_id. Any other family yields an unspecified endpoint.
+    static Endpoint FromSockaddr(const void* sockaddr);
+
+    Family family() const { return family_; }
+    uint16_t port() const { return port_; }
+    // Interface index that qualifies an IPv6 link-local (fe80::/10) address; 0 when unscoped and for IPv4
+    uint32_t scopeId() const { return scope_id_; }
+    bool isV4() const { return family_ == Family::IPv4; }
+    bool isV6() const { return family_ == Family::IPv6; }
+    bool isSpecified() const { return family_ != Family::Unspecified; }
+
+    // Address bytes in network order: 4 significant bytes for IPv4, 16 for IPv6
+    const uint8_t* bytes() const { return bytes_; }
+
+    // Writes the matching sockaddr into `storage`, which must hold at least a sockaddr_in6.
+    // Returns the sockaddr length, or 0 for an unspecified endpoint.
+    size_t toSockaddr(void* storage) const;
+
+    std::string ip() const;
+    std::string toString() const; // "1.2.3.4:5", "[::1]:5" or "[fe80::1%2]:5" with a scope id
+    Addr toAddr() const;          // Addr has no scope id, so a link-local endpoint loses it here
+
+    size_t hash() const noexcept {
+        uint64_t lo, hi;
+        std::memcpy(&lo, bytes_, sizeof(lo));
+        std::memcpy(&hi, bytes_ + 8, sizeof(hi));
+        uint64_t h = lo * 0x9E3779B97F4A7C15ULL;
+        h ^= (hi + (static_cast<uint64_t>(scope_id_) << 24 | static_cast<uint64_t>(port_) << 8 | static_cast<uint64_t>(family_))) * 0xC2B2AE3D27D4EB4FULL;
+        h ^= h >> 29;
+        return static_cast<size_t>(h);
+    }
+
+private:
+    uint8_t bytes_[16]{};
+    uint32_t scope_id_ = 0; // part of equality: the same link-local address on two interfaces is two peers
+    uint16_t port_ = 0;
+    Family family_ = Family::Unspecified;
+    uint8_t reserved_ = 0; // keeps the object free of indeterminate padding so it compares bytewise
+};
+
+static_assert(std::is_trivially_copyable_v<Endpoint>);
+static_assert(sizeof(Endpoint) == 24);
+
+inline bool operator==(const Endpoint& lhs, const Endpoint& rhs) {
+    return std::memcmp(&lhs, &rhs, sizeof(Endpoint)) == 0;
+}
+
+} // namespace pulse::net::udp
+
+namespace std {
+    template <>
+    struct hash<pulse::net::udp::Endpoint> {
+        size_t operator()(const pulse::net::udp::Endpoint& e) const noexcept {
+            return e.hash();
+        }
+    };
+}
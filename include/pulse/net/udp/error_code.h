@@ -20,6 +20,10 @@ namespace pulse::net::udp {
         SocketCreateFailed,
         SocketConfigFailed,
         WSAStartupFailed,
+        InvalidArgument,
+        NotSupported,
+        PoolExhausted,
+        PollFailed,
         Unknown = 9999
     };
 
@@ -42,6 +46,10 @@ namespace pulse::net::udp {
             case ErrorCode::SocketCreateFailed: return "Socket creation failed";
             case ErrorCode::SocketConfigFailed: return "Socket configuration failed";
             case ErrorCode::WSAStartupFailed: return "WSAStartup failed";
+            case ErrorCode::InvalidArgument: return "Invalid argument";
+            case ErrorCode::NotSupported: return "Not supported on this platform";
+            case ErrorCode::PoolExhausted: return "Buffer pool exhausted";
+            case ErrorCode::PollFailed: return "Readiness poll failed";
             default: return "Unknown error";
         }
     }
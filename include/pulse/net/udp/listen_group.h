@@ -0,0 +1,37 @@
+#pragma once
+
+#include "udp.h"
+#include "error_code.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <expected>
+
+namespace pulse::net::udp {
+
+// How the kernel picks the group member that receives a datagram
+enum class ListenSteering {
+    FlowHash,   // default 4-tuple hash
+    Cpu,        // socket (receiving CPU % socket_count), keeping a flow on the core that took its interrupt
+    PayloadKey  // socket (key % socket_count), key read big-endian from the UDP payload, e.g. a session id
+};
+
+struct ListenGroupConfig {
+    size_t socket_count = 0; // 0 opens one socket per hardware thread
+    bool pin_to_cpu = false; // socket i asks the kernel to prefer datagrams processed on CPU i (SO_INCOMING_CPU)
+    ListenSteering steering = ListenSteering::FlowHash;
+    size_t steering_key_offset = 0; // PayloadKey: byte offset of the key in the payload
+    size_t steering_key_size = 4;   // PayloadKey: 1, 2 or 4 bytes
+    SocketConfig socket;            // options for every member; reuse_port is forced on and pin_to_cpu overrides incoming_cpu
+};
+
+/// Opens several sockets bound to the same address with SO_REUSEPORT. The kernel hashes each flow to one member,
+/// so giving every socket its own worker thread scales ingress with cores.
+/// Non-default steering attaches a classic BPF program (SO_ATTACH_REUSEPORT_CBPF) that chooses the member instead.
+/// Only Linux load-balances such groups; elsewhere a group larger than one socket or any steering returns NotSupported.
+std::expected<std::vector<std::unique_ptr<Socket>>, ErrorCode> ListenGroup(const Addr& bindAddr, const ListenGroupConfig& config);
+
+/// Pins the calling thread to `cpu`, e.g. the worker serving ListenGroup member `cpu` when pin_to_cpu is set.
+std::expected<void, ErrorCode> PinCurrentThread(size_t cpu);
+
+} // namespace pulse::net::udp
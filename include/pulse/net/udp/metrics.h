@@ -0,0 +1,95 @@
+#pragma once
+
+#include "error_code.h"
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+
+namespace pulse::net::udp {
+
+// Log-linear latency buckets: exact below 16 ns, then 8 sub-buckets per power of two (<= 12.5% error) up to ~34 s
+inline constexpr unsigned kLatencySubBucketBits = 3;
+inline constexpr size_t kLatencyLinearBuckets = size_t{1} << (kLatencySubBucketBits + 1);
+inline constexpr unsigned kLatencyMaxExponent = 34;
+inline constexpr size_t kLatencyBuckets =
+    kLatencyLinearBuckets + (kLatencyMaxExponent - kLatencySubBucketBits) * (size_t{1} << kLatencySubBucketBits);
+
+// Error codes get one counter slot each; anything past the last slot (e.g. Unknown) is counted in it
+inline constexpr size_t kErrorCounterSlots = 32;
+
+constexpr size_t LatencyBucketIndex(uint64_t ns) {
+    if (ns < kLatencyLinearBuckets) {
+        return static_cast<size_t>(ns);
+    }
+    const unsigned exponent = static_cast<unsigned>(std::bit_width(ns)) - 1;
+    if (exponent > kLatencyMaxExponent) {
+        return kLatencyBuckets - 1;
+    }
+    const size_t sub = static_cast<size_t>(ns >> (exponent - kLatencySubBucketBits)) & ((size_t{1} << kLatencySubBucketBits) - 1);
+    return kLatencyLinearBuckets + (exponent - kLatencySubBucketBits - 1) * (size_t{1} << kLatencySubBucketBits) + sub;
+}
+
+// Largest value that lands in bucket `index`
+constexpr uint64_t LatencyBucketUpperBound(size_t index) {
+    if (index < kLatencyLinearBuckets) {
+        return index;
+    }
+    const size_t perOctave = size_t{1} << kLatencySubBucketBits;
+    const unsigned exponent = static_cast<unsigned>((index - kLatencyLinearBuckets) / perOctave) + kLatencySubBucketBits + 1;
+    const uint64_t sub = (index - kLatencyLinearBuckets) % perOctave;
+    const uint64_t width = uint64_t{1} << (exponent - kLatencySubBucketBits);
+    return (uint64_t{1} << exponent) + (sub + 1) * width - 1;
+}
+
+static_assert(LatencyBucketIndex(LatencyBucketUpperBound(100)) == 100);
+static_assert(LatencyBucketIndex(LatencyBucketUpperBound(100) + 1) == 101);
+
+struct LatencyHistogram {
+    uint64_t counts[kLatencyBuckets];
+    uint64_t samples;
+    uint64_t sum_ns;
+    uint64_t max_ns;
+
+    // Upper bound of the bucket holding quantile `q` in [0, 1]; 0 when empty
+    uint64_t percentile(double q) const {
+        if (samples == 0) {
+            return 0;
+        }
+        const auto rank = static_cast<uint64_t>(q * static_cast<double>(samples - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kLatencyBuckets; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                return LatencyBucketUpperBound(i) < max_ns ? LatencyBucketUpperBound(i) : max_ns;
+            }
+        }
+        return max_ns;
+    }
+};
+
+// Point-in-time copy of a socket's counters. Values are cumulative since the socket was opened;
+// diff two snapshots to get rates.
+struct SocketMetrics {
+    uint64_t packets_sent;
+    uint64_t bytes_sent;
+    uint64_t packets_received;
+    uint64_t bytes_received;
+    uint64_t send_calls;       // send syscalls / submissions, successful or not
+    uint64_t recv_calls;       // receive syscalls / completion harvests, successful or not
+    uint64_t truncated;        // datagrams cut to fit the receive buffer, where the kernel reports it
+    uint64_t dropped;          // datagrams discarded by the library, e.g. from an undecodable source
+    uint64_t send_errors[kErrorCounterSlots];
+    uint64_t recv_errors[kErrorCounterSlots];
+    LatencyHistogram send_latency; // per send syscall
+    LatencyHistogram recv_latency; // per receive syscall that returned data
+
+    uint64_t sendErrors(ErrorCode code) const { return send_errors[ErrorSlot(code)]; }
+    uint64_t recvErrors(ErrorCode code) const { return recv_errors[ErrorSlot(code)]; }
+
+    static constexpr size_t ErrorSlot(ErrorCode code) {
+        const auto slot = static_cast<size_t>(code);
+        return slot < kErrorCounterSlots ? slot : kErrorCounterSlots - 1;
+    }
+};
+
+} // namespace pulse::net::udp
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "endpoint.h"
+#include "error_code.h"
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <expected>
+
+namespace pulse::net::udp {
+
+// Largest UDP payload a PacketBuffer can be asked to hold
+inline constexpr size_t kMaxDatagramSize = 65535;
+
+class PacketPool;
+
+// Owning, move-only handle to one datagram's bytes plus its peer endpoint.
+// Fill it with Socket::recvInto() and hand it to another thread or queue it without copying.
+// Storage comes from the heap (Create) or from a PacketPool (PacketPool::acquire), and goes back where it came from on destruction.
+class PacketBuffer {
+public:
+    // Allocates `capacity` bytes (1..kMaxDatagramSize). Do this up front, not per packet.
+    static std::expected<PacketBuffer, ErrorCode> Create(size_t capacity);
+
+    PacketBuffer() = default; // empty handle with no storage
+    PacketBuffer(PacketBuffer&& other) noexcept;
+    PacketBuffer& operator=(PacketBuffer&& other) noexcept;
+    PacketBuffer(const PacketBuffer&) = delete;
+    PacketBuffer& operator=(const PacketBuffer&) = delete;
+    ~PacketBuffer() = default;
+
+    explicit operator bool() const { return storage_ != nullptr; }
+
+    uint8_t* data() { return storage_.get(); }
+    const uint8_t* data() const { return storage_.get(); }
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+
+    // Whole backing storage, for writing a payload or receiving into
+    std::span<uint8_t> storage() { return {storage_.get(), capacity_}; }
+
+    // Sets the payload length; fails with InvalidArgument beyond capacity()
+    std::expected<void, ErrorCode> resize(size_t size);
+
+    const Endpoint& addr() const { return addr_; }
+    void setAddr(const Endpoint& addr) { addr_ = addr; }
+
+    // Set by Socket::recvInto() when the datagram was larger than capacity() and got cut
+    bool truncated() const { return truncated_; }
+    void setTruncated(bool truncated) { truncated_ = truncated; }
+
+private:
+    friend class PacketPool;
+
+    struct StorageDeleter {
+        PacketPool* pool; // nullptr means heap storage
+        void operator()(uint8_t* storage) const noexcept;
+    };
+
+    PacketBuffer(uint8_t* storage, size_t capacity, PacketPool* pool);
+
+    std::unique_ptr<uint8_t[], StorageDeleter> storage_;
+    size_t capacity_ = 0;
+    size_t size_ = 0;
+    Endpoint addr_;
+    bool truncated_ = false;
+};
+
+} // namespace pulse::net::udp
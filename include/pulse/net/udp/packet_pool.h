@@ -0,0 +1,64 @@
+#pragma once
+
+#include "packet_buffer.h"
+#include "error_code.h"
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <expected>
+
+namespace pulse::net::udp {
+
+// Slab sizes of the two buffer classes a PacketPool hands out
+inline constexpr size_t kMtuBufferSize = 2048;
+inline constexpr size_t kJumboBufferSize = kMaxDatagramSize;
+
+struct PacketPoolConfig {
+    size_t mtu_buffers = 4096;      // MTU-class slabs, preallocated
+    size_t jumbo_buffers = 64;      // jumbo-class slabs, preallocated
+    size_t thread_cache_size = 128; // buffers per class a thread keeps locally before returning them to the shared list
+};
+
+struct PacketPoolStats {
+    size_t mtu_in_use;
+    size_t mtu_high_water;
+    size_t jumbo_in_use;
+    size_t jumbo_high_water;
+    uint64_t cross_thread_frees; // buffers released on a different thread than the one that acquired them
+    uint64_t exhausted;          // acquire() calls that found the class empty
+};
+
+// Fixed-size slab allocator for PacketBuffers. All slab memory is reserved by Create(). Buffer release never hits malloc;
+// acquire() allocates only once per thread and pool, to register that thread's cache on its first call.
+// Each thread serves acquires and same-thread releases from its own free list; buffers released on another
+// thread go back through a lock-free shared list, so receive-on-one-thread, free-on-another pipelines stay cheap.
+// Every buffer must be released before the pool is destroyed.
+class PacketPool {
+public:
+    virtual ~PacketPool() = default;
+
+    static std::expected<std::unique_ptr<PacketPool>, ErrorCode> Create(const PacketPoolConfig& config);
+
+    // Returns an empty buffer with capacity >= `size`: MTU class when it fits, jumbo class otherwise.
+    // Fails with PoolExhausted when that class has nothing free, InvalidArgument above kJumboBufferSize.
+    virtual std::expected<PacketBuffer, ErrorCode> acquire(size_t size = kMtuBufferSize) = 0;
+
+    virtual PacketPoolStats stats() const = 0;
+
+protected:
+    PacketPool() = default;
+    PacketPool(const PacketPool&) = delete;
+    PacketPool& operator=(const PacketPool&) = delete;
+
+    static PacketBuffer wrap(uint8_t* storage, size_t capacity, PacketPool* pool) {
+        return PacketBuffer(storage, capacity, pool);
+    }
+
+private:
+    friend class PacketBuffer;
+
+    // Called by PacketBuffer's destructor with storage this pool handed out
+    virtual void release(uint8_t* storage) noexcept = 0;
+};
+
+} // namespace pulse::net::udp
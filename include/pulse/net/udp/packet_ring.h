@@ -0,0 +1,110 @@
+#pragma once
+
+#include "udp.h"
+#include "packet_buffer.h"
+#include "packet_pool.h"
+#include "error_code.h"
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <expected>
+
+namespace pulse::net::udp {
+
+// Padding unit that keeps producer-owned and consumer-owned ring state on separate cache lines
+inline constexpr size_t kCacheLineSize = 64;
+
+enum class RingProducers {
+    Single,  // one thread pushes, e.g. the I/O thread feeding a worker
+    Multiple // any number of threads push, e.g. workers handing replies back to the I/O thread
+};
+
+struct PacketRingStats {
+    uint64_t pushed;   // packets accepted so far
+    uint64_t popped;   // packets taken out so far
+    uint64_t rejected; // tryPush() calls refused because the ring was full
+    size_t high_water; // most packets the consumer has found queued at once
+};
+
+struct PumpReceiveResult {
+    size_t moved;   // datagrams pushed onto the ring
+    size_t dropped; // datagrams received but lost because other producers filled the ring meanwhile
+};
+
+struct PumpSendResult {
+    size_t moved;   // packets the socket accepted
+    size_t dropped; // packets taken off the ring because the kernel rejected them outright
+};
+
+/// Bounded lock-free FIFO of PacketBuffers with exactly one consuming thread. Every slot carries a sequence number and
+/// sits on its own cache line, so the producer and the consumer only meet on the slot being handed over, and the
+/// packet bytes themselves never move. Capacity is fixed by Create(); a full ring refuses pushes instead of growing.
+class PacketRing {
+public:
+    /// `capacity` is rounded up to a power of two, 1..2^30.
+    static std::expected<std::unique_ptr<PacketRing>, ErrorCode> Create(size_t capacity, RingProducers producers = RingProducers::Single);
+
+    PacketRing(const PacketRing&) = delete;
+    PacketRing& operator=(const PacketRing&) = delete;
+    ~PacketRing() = default;
+
+    /// Producer side. Moves from `packet` only when it returns true; false means the ring is full.
+    bool tryPush(PacketBuffer& packet);
+
+    /// Producer side. True when a push would currently fail; with several producers the answer may be stale at once.
+    bool full() const;
+
+    /// Consumer side. Moves the oldest packet into `out`; false when the ring is empty.
+    bool tryPop(PacketBuffer& out);
+
+    /// Consumer side. Moves up to `out.size()` packets, oldest first, and returns how many.
+    size_t popBatch(std::span<PacketBuffer> out);
+
+    /// Consumer side. Points `out` at the oldest packets without removing them and returns how many; they stay valid
+    /// until consume(), which releases the first `count` of them. Lets the consumer retry what a socket refused.
+    size_t peek(std::span<PacketBuffer*> out);
+    void consume(size_t count);
+
+    /// Packets queued right now; approximate while other threads are pushing or popping.
+    size_t size() const;
+    size_t capacity() const { return mask_ + 1; }
+    PacketRingStats stats() const;
+
+private:
+    struct alignas(kCacheLineSize) Cell {
+        std::atomic<uint64_t> sequence; // == position when free for the push at `position`, position + 1 once filled
+        PacketBuffer packet;
+    };
+
+    PacketRing(size_t capacity, RingProducers producers);
+
+    std::unique_ptr<Cell[]> cells_;
+    const uint64_t mask_;
+    const bool multi_producer_;
+
+    alignas(kCacheLineSize) std::atomic<uint64_t> tail_{0}; // next push position
+    std::atomic<uint64_t> rejected_{0};
+
+    alignas(kCacheLineSize) std::atomic<uint64_t> head_{0}; // next pop position, written by the consumer only
+    std::atomic<size_t> high_water_{0};
+};
+
+/// One step of an I/O thread feeding workers: receives up to `maxPackets` datagrams into buffers from `pool` and pushes
+/// them onto `ring`. Stops early, before receiving, once the ring is full, so backpressure leaves datagrams in the
+/// socket buffer rather than dropping them here; it also stops when the pool is empty or nothing is pending.
+/// With a Single-producer ring nothing is ever dropped. On a Multiple-producer ring another thread can fill the last
+/// slot between that check and the push; the datagram already read is then dropped and reported in `dropped`.
+/// Fails only on a socket error other than WouldBlock before any datagram was read.
+/// The library starts no threads: call this from the caller's I/O loop, e.g. when a Poller reports the socket readable.
+std::expected<PumpReceiveResult, ErrorCode> PumpReceive(Socket& socket, PacketPool& pool, PacketRing& ring, size_t maxPackets = kMaxRecvBatch);
+
+/// The reverse step: sends up to `maxPackets` packets from `ring`, each to its PacketBuffer::addr(), with sendBatch().
+/// Packets the socket does not accept stay at the front of the ring for the next call; one the kernel rejects outright
+/// (say, an unreachable destination) is dropped so it cannot stall the ring, and reported in `dropped`. Both counts
+/// may be 0; fails only when the socket is unusable (InvalidSocket) before any packet went out.
+/// Call it from the ring's consumer thread.
+std::expected<PumpSendResult, ErrorCode> PumpSend(PacketRing& ring, Socket& socket, size_t maxPackets = kMaxSendBatch);
+
+} // namespace pulse::net::udp
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "udp.h"
+#include "endpoint.h"
+#include "error_code.h"
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <expected>
+
+namespace pulse::net::udp {
+
+struct PeerSessionConfig {
+    bool connected = false; // give the session its own socket connected to the peer (Linux)
+    SocketConfig socket;    // options for that socket; reuse_port is forced on
+};
+
+/// A long-lived conversation with one peer of a Listen() socket.
+/// By default sends leave through the listener, to a destination encoded once when the session opens.
+/// With `connected`, the session owns a socket bound to the listener's address through SO_REUSEPORT and connected
+/// to the peer: sends carry no address and reuse the cached route, and the kernel delivers that peer's datagrams to
+/// the session's socket instead of the listener. The listener must then have been opened with SocketConfig::reuse_port.
+/// Other peers' datagrams that reach the new socket between its bind() and connect() are discarded and counted in
+/// discarded() (and in that socket's SocketMetrics::dropped when metrics are built in), so open sessions when a peer
+/// first appears rather than in the middle of a burst.
+class PeerSession {
+public:
+    /// `listener` must outlive the session. Fails with InvalidAddress for an unspecified peer or one whose family
+    /// differs from the listener's, BindFailed when a connected session cannot share the listener's port, and
+    /// NotSupported for connected sessions off Linux.
+    static std::expected<PeerSession, ErrorCode> Open(Socket& listener, const Endpoint& peer, const PeerSessionConfig& config = {});
+
+    PeerSession(PeerSession&&) noexcept = default;
+    PeerSession& operator=(PeerSession&&) noexcept = default;
+    PeerSession(const PeerSession&) = delete;
+    PeerSession& operator=(const PeerSession&) = delete;
+    ~PeerSession() = default;
+
+    const Endpoint& peer() const { return peer_; }
+    bool connected() const { return connected_ != nullptr; }
+
+    /// Other peers' datagrams the connected socket threw away while it was being opened; always 0 when unconnected.
+    size_t discarded() const { return discarded_; }
+
+    /// The connected per-peer socket, for recvFrom()/recvBatch() and Poller registration.
+    /// nullptr for an unconnected session, whose peer's datagrams keep arriving on the listener.
+    Socket* socket() const { return connected_.get(); }
+
+    std::expected<void, ErrorCode> send(const uint8_t* data, size_t length);
+
+    /// Sends every packet to the peer regardless of its `addr`; same return contract as Socket::sendBatch().
+    std::expected<size_t, ErrorCode> sendBatch(std::span<const OutgoingPacket> packets);
+
+    /// Socket::sendSegmented() towards the peer.
+    std::expected<size_t, ErrorCode> sendSegmented(const uint8_t* data, size_t length, size_t segmentSize);
+
+private:
+    PeerSession(Socket& listener, const Endpoint& peer, std::unique_ptr<Socket> connected, size_t discarded = 0)
+        : listener_(&listener), peer_(peer), connected_(std::move(connected)), discarded_(discarded) {}
+
+    Socket* listener_;
+    Endpoint peer_;
+    std::unique_ptr<Socket> connected_;
+    size_t discarded_;
+};
+
+} // namespace pulse::net::udp
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "udp.h"
+#include "error_code.h"
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <expected>
+
+namespace pulse::net::udp {
+
+// Pass as wait()'s timeout to block until something is ready
+inline constexpr uint64_t kWaitForever = UINT64_MAX;
+
+// Most events a single wait() call reports; the rest stay pending for the next call
+inline constexpr size_t kMaxPollEvents = 256;
+
+struct PollInterest {
+    bool readable = true;
+    bool writable = false;
+};
+
+struct PollEvent {
+    Socket* socket;
+    uint64_t token; // value given to add()
+    bool readable;
+    bool writable;
+    bool error;
+};
+
+// Readiness notification for many sockets: epoll on Linux, poll()/WSAPoll() elsewhere.
+// Registration is level-triggered, so a socket keeps reporting readable until recvFrom() returns WouldBlock.
+class Poller {
+public:
+    virtual ~Poller() = default;
+
+    static std::expected<std::unique_ptr<Poller>, ErrorCode> Create();
+
+    // Starts watching `socket`; it must outlive its registration. Registering the same socket twice is InvalidArgument.
+    virtual std::expected<void, ErrorCode> add(Socket& socket, uint64_t token, PollInterest interest = {}) = 0;
+
+    // Changes what a registered socket is watched for, e.g. adding writable while a send backlog drains
+    virtual std::expected<void, ErrorCode> modify(Socket& socket, PollInterest interest) = 0;
+
+    // Stops watching `socket`; still valid after socket.close(), which frees its fd for reuse by a later add()
+    virtual std::expected<void, ErrorCode> remove(Socket& socket) = 0;
+
+    /// Waits up to `timeout_ns` (0 polls without blocking, kWaitForever blocks) for registered sockets to become ready.
+    /// Returns an empty span on timeout. The span is valid only until the next wait() call.
+    /// With nothing registered a finite timeout just sleeps; kWaitForever fails with InvalidArgument instead of hanging.
+    virtual std::expected<std::span<const PollEvent>, ErrorCode> wait(uint64_t timeout_ns) = 0;
+
+protected:
+    Poller() = default;
+    Poller(const Poller&) = delete;
+    Poller& operator=(const Poller&) = delete;
+};
+
+} // namespace pulse::net::udp
@@ -0,0 +1,214 @@
+#pragma once
+
+#include "udp.h"
+#include "endpoint.h"
+#include "poller.h"
+#include "task.h"
+#include "error_code.h"
+#include <coroutine>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+#include <expected>
+
+namespace pulse::net::udp {
+
+class Reactor;
+
+namespace detail {
+
+// A coroutine suspended until its socket is ready. The Reactor retries the operation itself when readiness arrives
+// and resumes the coroutine only once it completed, so a spurious wake-up never reaches the caller.
+struct IoWaiter {
+    std::coroutine_handle<> handle;
+    uint64_t seq = 0; // tells this wait apart from later ones on the same socket when its timeout fires
+
+    virtual bool attempt() = 0; // retries the operation; false while it would still block
+    virtual void expire() = 0;  // the deadline passed first
+
+protected:
+    ~IoWaiter() = default;
+};
+
+} // namespace detail
+
+/// Result of co_await AsyncSocket::recv(): the datagram, or Timeout, or the socket's error.
+class RecvAwaiter final : public detail::IoWaiter {
+public:
+    bool await_ready();
+    bool await_suspend(std::coroutine_handle<> awaiting);
+    std::expected<ReceivedPacket, ErrorCode> await_resume() const { return result_; }
+
+    bool attempt() override;
+    void expire() override;
+
+private:
+    friend class AsyncSocket;
+
+    RecvAwaiter(Reactor& reactor, uint32_t slot, Socket& socket, std::span<uint8_t> buffer, uint64_t timeoutNs)
+        : reactor_(&reactor), slot_(slot), socket_(&socket), buffer_(buffer), timeout_ns_(timeoutNs) {}
+
+    Reactor* reactor_;
+    uint32_t slot_;
+    Socket* socket_;
+    std::span<uint8_t> buffer_;
+    uint64_t timeout_ns_;
+    std::expected<ReceivedPacket, ErrorCode> result_ = std::unexpected(ErrorCode::WouldBlock);
+};
+
+/// Result of co_await AsyncSocket::send()/sendTo(): success once the kernel took the datagram.
+class SendAwaiter final : public detail::IoWaiter {
+public:
+    bool await_ready();
+    bool await_suspend(std::coroutine_handle<> awaiting);
+    std::expected<void, ErrorCode> await_resume() const { return result_; }
+
+    bool attempt() override;
+    void expire() override;
+
+private:
+    friend class AsyncSocket;
+
+    SendAwaiter(Reactor& reactor, uint32_t slot, Socket& socket, const Endpoint& addr, const uint8_t* data, size_t length,
+                uint64_t timeoutNs)
+        : reactor_(&reactor), slot_(slot), socket_(&socket), addr_(addr), data_(data), length_(length), timeout_ns_(timeoutNs) {}
+
+    Reactor* reactor_;
+    uint32_t slot_;
+    Socket* socket_;
+    Endpoint addr_; // unspecified sends to the connected address
+    const uint8_t* data_;
+    size_t length_;
+    uint64_t timeout_ns_;
+    std::expected<void, ErrorCode> result_ = std::unexpected(ErrorCode::WouldBlock);
+};
+
+/// co_await Reactor::sleepFor()/sleepUntil().
+class SleepAwaiter {
+public:
+    bool await_ready() const;
+    void await_suspend(std::coroutine_handle<> awaiting) const;
+    void await_resume() const noexcept {}
+
+private:
+    friend class Reactor;
+
+    SleepAwaiter(Reactor& reactor, uint64_t deadlineNs) : reactor_(&reactor), deadline_ns_(deadlineNs) {}
+
+    Reactor* reactor_;
+    uint64_t deadline_ns_;
+};
+
+/// Single-threaded event loop that runs coroutines over non-blocking sockets, so per-peer logic reads sequentially
+/// without a thread per peer. Awaiting I/O first tries the non-blocking call and suspends only on WouldBlock; the
+/// reactor then watches the socket through a Poller and resumes the coroutine from runOnce() when the call completes
+/// or its timeout passes. The library starts no threads: the caller's loop drives run()/runOnce().
+/// All coroutines, sockets and the reactor itself belong to the thread that calls runOnce().
+class Reactor {
+public:
+    static std::expected<std::unique_ptr<Reactor>, ErrorCode> Create();
+
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+    ~Reactor(); // destroys tasks that have not finished
+
+    /// Takes ownership of `task` and runs it until its first suspension.
+    void spawn(Task<void> task);
+
+    /// Waits up to `timeoutNs` for I/O or a timer, then resumes every coroutine whose wait completed.
+    /// Returns how many were resumed.
+    std::expected<size_t, ErrorCode> runOnce(uint64_t timeoutNs = kWaitForever);
+
+    /// Calls runOnce() until every spawned task has finished.
+    std::expected<void, ErrorCode> run();
+
+    /// Spawned tasks that have not finished yet.
+    size_t tasks() const;
+
+    SleepAwaiter sleepFor(uint64_t durationNs);
+    SleepAwaiter sleepUntil(uint64_t deadlineNs);
+
+    /// Steady-clock nanoseconds, the clock of sleepUntil() and of every deadline.
+    static uint64_t now();
+
+private:
+    friend class AsyncSocket;
+    friend class RecvAwaiter;
+    friend class SendAwaiter;
+    friend class SleepAwaiter;
+
+    struct SocketSlot {
+        Socket* socket = nullptr; // nullptr while the slot is free
+        uint32_t generation = 0;
+        detail::IoWaiter* reader = nullptr;
+        detail::IoWaiter* writer = nullptr;
+        PollInterest interest{.readable = false, .writable = false};
+        bool registered = false; // dropped from the poller while an error is pending and nobody waits
+    };
+
+    struct Timer {
+        uint64_t deadline_ns;
+        uint64_t seq;
+        std::coroutine_handle<> sleeper; // set for sleeps; I/O timeouts find their waiter through the slot
+        uint32_t slot;
+        uint32_t generation;
+        bool write;
+    };
+
+    explicit Reactor(std::unique_ptr<Poller> poller);
+
+    std::expected<uint32_t, ErrorCode> attach(Socket& socket);
+    void detach(uint32_t slot);
+    std::expected<void, ErrorCode> park(uint32_t slot, detail::IoWaiter& waiter, bool write, uint64_t timeoutNs);
+    void addTimer(const Timer& timer);
+    void updateInterest(uint32_t slot);
+    void expireTimers();
+
+    std::unique_ptr<Poller> poller_;
+    std::vector<SocketSlot> slots_;
+    std::vector<uint32_t> free_slots_;
+    std::vector<Timer> timers_; // min-heap on deadline_ns
+    std::vector<std::coroutine_handle<>> runnable_;
+    std::vector<Task<void>> roots_;
+    uint64_t next_seq_ = 1;
+};
+
+/// A Socket driven by a Reactor. Receives land in storage owned by this object, so a packet from co_await recv()
+/// stays valid until the next recv() on the same AsyncSocket, whatever other coroutines do meanwhile.
+/// At most one recv() and one send()/sendTo() may be suspended at a time; a second fails with InvalidArgument.
+/// Both the reactor and the socket must outlive this object.
+class AsyncSocket {
+public:
+    /// Registers `socket` with `reactor`. `bufferSize` is the receive storage, 1..kMaxDatagramSize; larger datagrams
+    /// arrive truncated.
+    static std::expected<AsyncSocket, ErrorCode> Attach(Reactor& reactor, Socket& socket, size_t bufferSize = kDefaultMaxDatagramSize);
+
+    AsyncSocket(AsyncSocket&& other) noexcept;
+    AsyncSocket& operator=(AsyncSocket&& other) noexcept;
+    AsyncSocket(const AsyncSocket&) = delete;
+    AsyncSocket& operator=(const AsyncSocket&) = delete;
+    ~AsyncSocket();
+
+    /// Next datagram, waiting up to `timeoutNs` (kWaitForever waits indefinitely); Timeout if none arrived.
+    RecvAwaiter recv(uint64_t timeoutNs = kWaitForever);
+
+    /// Sends, waiting up to `timeoutNs` for room in the socket buffer when it is full.
+    SendAwaiter sendTo(const Endpoint& addr, const uint8_t* data, size_t length, uint64_t timeoutNs = kWaitForever);
+    SendAwaiter send(const uint8_t* data, size_t length, uint64_t timeoutNs = kWaitForever);
+
+    Socket& socket() const { return *socket_; }
+
+private:
+    AsyncSocket(Reactor& reactor, uint32_t slot, Socket& socket, std::unique_ptr<uint8_t[]> buffer, size_t bufferSize)
+        : reactor_(&reactor), slot_(slot), socket_(&socket), buffer_(std::move(buffer)), buffer_size_(bufferSize) {}
+
+    Reactor* reactor_;
+    uint32_t slot_;
+    Socket* socket_;
+    std::unique_ptr<uint8_t[]> buffer_;
+    size_t buffer_size_;
+};
+
+} // namespace pulse::net::udp
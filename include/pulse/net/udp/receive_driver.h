@@ -0,0 +1,73 @@
+#pragma once
+
+#include "udp.h"
+#include "poller.h"
+#include "error_code.h"
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <expected>
+
+namespace pulse::net::udp {
+
+struct ReceiveDriverConfig {
+    uint64_t max_spin_ns = 50'000; // longest spin before parking; 0 always parks straight away
+    uint64_t min_spin_ns = 0;      // spin at least this long even when traffic is sparse
+    uint32_t spin_multiplier = 2;  // spin for this many smoothed inter-arrival gaps
+};
+
+struct ReceiveDriverStats {
+    uint64_t received;       // datagrams returned
+    uint64_t spun;           // of those, found while spinning after the socket had come up empty
+    uint64_t parked;         // times the spin budget ran out and the driver waited on readiness
+    uint64_t avg_gap_ns;     // smoothed time between arrivals
+    uint64_t spin_budget_ns; // current spin budget
+};
+
+/// Hybrid receive loop for one socket: after the socket comes up empty it spins on the non-blocking receive for a
+/// budget, then parks on readiness (epoll/poll) until data arrives. The budget follows an exponentially weighted
+/// average of inter-arrival gaps: while the next datagram is expected within max_spin_ns the driver spins for
+/// spin_multiplier gaps and answers in microseconds; once arrivals are further apart than that, spinning could
+/// not catch them and it parks right away, so an idle socket costs no CPU.
+/// Spinning only pays when the sender runs on another core; on a single CPU set max_spin_ns to 0.
+/// Not thread-safe; the socket must outlive the driver.
+class ReceiveDriver {
+public:
+    /// Registers `socket` with a Poller of its own. Fails with InvalidArgument for a zero spin_multiplier or
+    /// min_spin_ns above max_spin_ns, or with the Poller's error.
+    static std::expected<ReceiveDriver, ErrorCode> Create(Socket& socket, const ReceiveDriverConfig& config = {});
+
+    ReceiveDriver(ReceiveDriver&&) noexcept = default;
+    ReceiveDriver& operator=(ReceiveDriver&&) noexcept = default;
+    ReceiveDriver(const ReceiveDriver&) = delete;
+    ReceiveDriver& operator=(const ReceiveDriver&) = delete;
+    ~ReceiveDriver() = default;
+
+    /// Socket::recvFrom() that waits up to `timeoutNs` (kWaitForever blocks) instead of returning WouldBlock;
+    /// fails with Timeout when nothing arrived in time. `data` has recvFrom()'s lifetime.
+    std::expected<ReceivedPacket, ErrorCode> next(uint64_t timeoutNs = kWaitForever);
+
+    /// Socket::recvBatch() with the same waiting; returns at least one datagram unless it fails.
+    std::expected<size_t, ErrorCode> nextBatch(std::span<ReceivedPacket> packets, uint64_t timeoutNs = kWaitForever);
+
+    ReceiveDriverStats stats() const;
+
+private:
+    ReceiveDriver(Socket& socket, std::unique_ptr<Poller> poller, const ReceiveDriverConfig& config);
+
+    template <typename Receive>
+    auto drive(Receive&& receive, uint64_t timeoutNs) -> decltype(receive());
+
+    void arrived(uint64_t arrivalNs, uint64_t count);
+
+    Socket* socket_;
+    std::unique_ptr<Poller> poller_;
+    ReceiveDriverConfig config_;
+    uint64_t last_arrival_ns_ = 0;
+    uint64_t avg_gap_ns_ = 0;
+    uint64_t spin_budget_ns_ = 0;
+    ReceiveDriverStats stats_{};
+};
+
+} // namespace pulse::net::udp
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "udp.h"
+#include "endpoint.h"
+#include "error_code.h"
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <expected>
+
+namespace pulse::net::udp {
+
+struct SendQueueConfig {
+    size_t max_datagrams = 1024;     // datagrams held between flushes
+    size_t max_bytes = 1024 * 1024;  // payload bytes held between flushes
+};
+
+struct SendQueueStats {
+    uint64_t sent;      // datagrams the kernel accepted
+    uint64_t segmented; // of those, datagrams that went down in a sendSegmented() run
+    uint64_t deferred;  // flushes that stopped on a full socket buffer and kept the rest queued
+    uint64_t dropped;   // datagrams discarded because the kernel rejected them outright
+};
+
+/// Collects the datagrams produced during a tick and hands them to the socket in one flush() at its end.
+/// push() copies each payload into a buffer reserved by Create(), so callers can reuse their own buffers at once.
+/// flush() keeps the push order and picks the cheapest call for each stretch of the queue: consecutive datagrams to
+/// the same peer with one segment size (the last may be shorter) go through sendSegmented(), the rest through
+/// sendBatch(). When the socket buffer fills, whatever the kernel did not take stays queued for the next flush().
+/// Not thread-safe; the socket must outlive the queue.
+class SendQueue {
+public:
+    /// Fails with InvalidArgument when either limit is zero.
+    static std::expected<SendQueue, ErrorCode> Create(Socket& socket, const SendQueueConfig& config = {});
+
+    SendQueue(SendQueue&&) noexcept = default;
+    SendQueue& operator=(SendQueue&&) noexcept = default;
+    SendQueue(const SendQueue&) = delete;
+    SendQueue& operator=(const SendQueue&) = delete;
+    ~SendQueue() = default;
+
+    /// Queues a copy of `length` bytes for `addr`; an unspecified `addr` sends to the connected address.
+    /// Fails with InvalidArgument above kMaxDatagramSize and PoolExhausted when either limit would be exceeded,
+    /// in which case flush() first.
+    std::expected<void, ErrorCode> push(const Endpoint& addr, const uint8_t* data, size_t length);
+
+    /// Sends as much of the queue as the socket takes and returns how many datagrams went out. A full socket buffer
+    /// is not an error: the remainder stays queued, in order, and pending() says how much. A datagram the kernel
+    /// rejects for any other reason is dropped and counted, so one bad destination cannot stall the queue.
+    /// Fails only when the socket itself is unusable (InvalidSocket), leaving every unsent datagram queued.
+    std::expected<size_t, ErrorCode> flush();
+
+    /// Discards everything queued.
+    void clear();
+
+    size_t pending() const { return count_; }
+    size_t pendingBytes() const { return bytes_used_; }
+    bool empty() const { return count_ == 0; }
+    const SendQueueStats& stats() const { return stats_; }
+
+private:
+    struct Entry {
+        Endpoint addr;
+        size_t offset; // into bytes_
+        size_t length;
+    };
+
+    SendQueue(Socket& socket, const SendQueueConfig& config);
+
+    size_t segmentRun(size_t first) const;
+    void consume(size_t count);
+
+    Socket* socket_;
+    std::unique_ptr<Entry[]> entries_;
+    std::unique_ptr<uint8_t[]> bytes_;
+    size_t max_datagrams_;
+    size_t max_bytes_;
+    size_t count_ = 0;
+    size_t bytes_used_ = 0;
+    SendQueueStats stats_{};
+};
+
+} // namespace pulse::net::udp
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "endpoint.h"
+#include "error_code.h"
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <expected>
+
+namespace pulse::net::udp {
+
+// Names one live session. `index` is a dense slot in [0, capacity()), so per-session state can live in a plain
+// array indexed by it; `generation` changes whenever the slot is freed, so a handle kept past eviction stops matching.
+struct SessionHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool operator==(const SessionHandle&) const = default;
+};
+
+struct SessionLookup {
+    SessionHandle handle;
+    bool created; // the peer had no session; reset whatever state is kept at handle.index
+};
+
+/// Maps peer endpoints to session handles for a datagram server. Open addressing with linear probing over
+/// 8-byte buckets (hash tag + slot index) keeps a lookup to one or two cache lines, and backward-shift deletion
+/// keeps probe runs short without tombstones. Sessions are also threaded on a recency list, so touch() and
+/// evictIdle() are O(1) per session. All storage is allocated by Create(); nothing allocates afterwards.
+/// Not thread-safe: give each receive thread its own table, e.g. one per ListenGroup member.
+class SessionTable {
+public:
+    /// `capacity` sessions at most (1..2^30). Sessions untouched for `idleTimeoutNs` become eligible for
+    /// evictIdle(); 0 keeps them until remove().
+    static std::expected<SessionTable, ErrorCode> Create(size_t capacity, uint64_t idleTimeoutNs);
+
+    SessionTable(SessionTable&&) noexcept = default;
+    SessionTable& operator=(SessionTable&&) noexcept = default;
+    SessionTable(const SessionTable&) = delete;
+    SessionTable& operator=(const SessionTable&) = delete;
+    ~SessionTable() = default;
+
+    /// Finds `peer`'s session, opening one if it has none, and marks it active at `nowNs`.
+    /// Returns PoolExhausted when a new session is needed but all slots are taken.
+    std::expected<SessionLookup, ErrorCode> touch(const Endpoint& peer, uint64_t nowNs);
+
+    /// Looks `peer` up without opening a session or refreshing its activity.
+    std::optional<SessionHandle> find(const Endpoint& peer) const;
+
+    bool contains(SessionHandle handle) const;
+
+    /// The peer behind a live handle; nullptr for a stale one.
+    const Endpoint* peer(SessionHandle handle) const;
+
+    /// Closes a session; false if the handle was already stale.
+    bool remove(SessionHandle handle);
+
+    /// Closes sessions idle for at least the configured timeout, oldest first, and writes their handles to
+    /// `evicted` so per-session state can be released. Returns how many were written; call again while it
+    /// returns `evicted.size()`.
+    size_t evictIdle(uint64_t nowNs, std::span<SessionHandle> evicted);
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+
+private:
+    static constexpr uint32_t kNone = UINT32_MAX;
+
+    struct Bucket {
+        uint32_t tag;  // 32-bit mix of the endpoint hash; tag & bucket_mask_ is the home bucket
+        uint32_t slot; // kNone when empty
+    };
+
+    struct Slot {
+        Endpoint peer;
+        uint32_t generation;
+        uint32_t prev; // recency list, least recently touched at head_
+        uint32_t next; // next on the recency list, or on the free list while unused
+        uint64_t last_seen_ns;
+        bool live;
+    };
+
+    SessionTable(size_t capacity, size_t bucketCount, uint64_t idleTimeoutNs);
+
+    uint32_t findBucket(const Endpoint& peer, uint32_t tag) const;
+    void eraseBucket(uint32_t bucket);
+    void unlink(uint32_t slot);
+    void pushBack(uint32_t slot);
+    void release(uint32_t slot);
+
+    std::unique_ptr<Bucket[]> buckets_;
+    std::unique_ptr<Slot[]> slots_;
+    size_t capacity_ = 0;
+    uint32_t bucket_mask_ = 0;
+    uint64_t idle_timeout_ns_ = 0;
+    size_t size_ = 0;
+    uint32_t free_ = kNone;
+    uint32_t head_ = kNone;
+    uint32_t tail_ = kNone;
+};
+
+} // namespace pulse::net::udp
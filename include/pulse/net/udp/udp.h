@@ -1,6 +1,10 @@
 #pragma once
 
 #include "udp_addr.h"
+#include "endpoint.h"
+#include "coalesced_packet.h"
+#include "packet_buffer.h"
+#include "metrics.h"
 #include "error_code.h"
 #include <vector>
 #include <memory>
@@ -8,15 +12,74 @@
 #include <optional>
 #include <utility>
 #include <expected>
+#include <span>
 
 namespace pulse::net::udp {
 
     struct ReceivedPacket {
         const uint8_t* data;
         size_t length;
-        Addr addr;
+        Endpoint addr;
+        uint64_t rx_timestamp_ns = 0; // kernel arrival time, CLOCK_REALTIME ns since the epoch; 0 unless SocketConfig::rx_timestamps
+        uint32_t drops = 0;           // datagrams this socket's full receive queue has dropped so far; needs SocketConfig::rx_drop_counter
+        bool truncated = false;       // the datagram did not fit; `data` holds only its first `length` bytes
+        size_t datagram_length = 0;   // size the sender sent; above `length` only when truncated, and 0 there if the platform cannot tell (Windows)
     };
 
+    struct OutgoingPacket {
+        Endpoint addr; // unspecified sends to the connected address
+        const uint8_t* data;
+        size_t length;
+    };
+
+    // Upper bound on the number of datagrams a single recvBatch() call will drain
+    inline constexpr size_t kMaxRecvBatch = 64;
+
+    // Number of datagrams handed to the kernel per sendmmsg() inside sendBatch()
+    inline constexpr size_t kMaxSendBatch = 64;
+
+    // Default per-datagram receive size (SocketConfig::max_datagram_size); covers a full Ethernet MTU
+    inline constexpr size_t kDefaultMaxDatagramSize = 2048;
+
+    // Segment and byte limits for one UDP GSO super-buffer handed to the kernel by sendSegmented()
+    inline constexpr size_t kMaxGsoSegments = 64;
+    inline constexpr size_t kMaxGsoBytes = 65000;
+
+// I/O mechanism behind a Socket
+enum class SocketBackend {
+    Syscall, // one recvfrom()/sendto() (or recvmmsg()/sendmmsg()) per call
+    IoUring  // Linux 6.0+: multishot recvmsg into a provided buffer ring, batched SENDMSG submissions.
+             // getHandle() then returns the ring fd for Poller registration, not the socket fd; GRO is unavailable.
+             // Each socket owns two rings and its receive slots (two extra fds, ~300 KiB at the default datagram size),
+             // so keep it for a few busy sockets rather than one per peer.
+};
+
+// Path MTU discovery mode (IP_MTU_DISCOVER / IPV6_MTU_DISCOVER)
+enum class MtuDiscovery {
+    Default, // leave the system setting
+    Dont,    // never set DF; the stack fragments oversized datagrams
+    Do,      // always set DF; oversized sends fail instead of fragmenting
+    Probe    // set DF but ignore the cached path MTU, e.g. for PMTU probing
+};
+
+// Options applied to the socket before bind()/connect(). If any of them fails the socket is closed and the
+// factory returns SocketConfigFailed (or NotSupported where the platform has no such option).
+struct SocketConfig {
+    SocketBackend backend = SocketBackend::Syscall;
+    size_t recv_buffer_size = 0; // SO_RCVBUF bytes; tries SO_RCVBUFFORCE first on Linux so rmem_max does not clamp it. 0 keeps the default
+    size_t send_buffer_size = 0; // SO_SNDBUF bytes, SO_SNDBUFFORCE first on Linux. 0 keeps the default
+    uint32_t busy_poll_us = 0;   // SO_BUSY_POLL: spin on the device queue this long in blocking receives (Linux). 0 leaves it off
+    int priority = -1;           // SO_PRIORITY queueing class (Linux). -1 leaves it unset
+    int dscp = -1;               // DSCP codepoint 0-63 written to IP_TOS / IPV6_TCLASS. -1 leaves it unset
+    MtuDiscovery mtu_discovery = MtuDiscovery::Default;
+    int incoming_cpu = -1;       // SO_INCOMING_CPU (Linux). -1 leaves it unset
+    bool reuse_port = false;     // SO_REUSEPORT
+    bool rx_timestamps = false;  // SO_TIMESTAMPNS: fill ReceivedPacket::rx_timestamp_ns (Linux)
+    bool rx_drop_counter = false; // SO_RXQ_OVFL: fill ReceivedPacket::drops (Linux)
+    size_t max_datagram_size = kDefaultMaxDatagramSize; // largest datagram recvFrom()/recvBatch() return whole, 1..kMaxDatagramSize.
+                                                        // Larger ones arrive with ReceivedPacket::truncated set
+};
+
 class Socket {
 public:
     virtual ~Socket() = default;
@@ -24,12 +87,62 @@ public:
     // Send a packet to the given address
     virtual std::expected<void, ErrorCode> sendTo(const Addr& addr, const uint8_t* data, size_t length) = 0;
 
+    // Send a packet to a binary endpoint, e.g. replying to ReceivedPacket::addr without formatting it
+    virtual std::expected<void, ErrorCode> sendTo(const Endpoint& addr, const uint8_t* data, size_t length) = 0;
+
     // Send a packet to the connected address
     virtual std::expected<void, ErrorCode> send(const uint8_t* data, size_t length) = 0;
 
+    /// Sends `packets` in order with as few syscalls as the platform allows.
+    /// Returns how many leading packets the kernel accepted; if that is fewer than `packets.size()`,
+    /// retry the remainder later. An error is returned only when not even the first packet was accepted.
+    virtual std::expected<size_t, ErrorCode> sendBatch(std::span<const OutgoingPacket> packets) = 0;
+
+    /// Sends `length` bytes to `addr` as consecutive datagrams of `segmentSize` bytes (the last one may be shorter).
+    /// Where the kernel supports UDP GSO the whole run goes down as a few large buffers and is split by the stack;
+    /// elsewhere it falls back to sendBatch(). An unspecified `addr` uses the connected address.
+    /// Returns the number of datagrams accepted, with the same retry contract as sendBatch().
+    virtual std::expected<size_t, ErrorCode> sendSegmented(const Endpoint& addr, const uint8_t* data, size_t length, size_t segmentSize) = 0;
+
     /// Receives a packet. The returned `data` pointer is valid only until the next recvFrom() call on the same thread.
     virtual std::expected<ReceivedPacket, ErrorCode> recvFrom() = 0;
 
+    /// Receives a packet into caller-owned `buffer`; `data` points into it and stays valid as long as the buffer does.
+    /// Datagrams larger than the buffer are cut to its size and reported through `truncated` / `datagram_length`.
+    virtual std::expected<ReceivedPacket, ErrorCode> recvFrom(std::span<uint8_t> buffer) = 0;
+
+    /// Receives a packet into `packet`'s storage and records its length and sender.
+    /// A datagram larger than the storage is cut to fit and flagged with PacketBuffer::truncated().
+    /// The filled handle owns its bytes and can be moved across threads without a copy.
+    virtual std::expected<void, ErrorCode> recvInto(PacketBuffer& packet) = 0;
+
+    /// Receives up to `packets.size()` datagrams (capped at kMaxRecvBatch) with as few syscalls as the platform allows.
+    /// Returns the number of slots filled, or WouldBlock if nothing was pending.
+    /// The returned `data` pointers are valid only until the next recvFrom()/recvBatch() call on the same thread.
+    virtual std::expected<size_t, ErrorCode> recvBatch(std::span<ReceivedPacket> packets) = 0;
+
+    /// Turns on UDP GRO so the kernel may merge back-to-back datagrams from one sender into a single receive.
+    /// Once enabled, read with recvCoalesced(); recvFrom()/recvBatch() would see merged payloads.
+    /// Returns NotSupported where the platform or kernel has no UDP GRO.
+    virtual std::expected<void, ErrorCode> enableGro() = 0;
+
+    /// Receives one buffer of up to kMaxCoalescedBytes together with its GRO segment size.
+    /// Works without enableGro() too, reporting each datagram as a single segment.
+    /// The returned `data` pointer is valid only until the next recvCoalesced() call on the same socket.
+    virtual std::expected<CoalescedPacket, ErrorCode> recvCoalesced() = 0;
+
+    /// Snapshot of this socket's traffic counters, error counts and syscall latency histograms.
+    /// Returns NotSupported unless the library was built with PULSENET_UDP_METRICS.
+    virtual std::expected<SocketMetrics, ErrorCode> metrics() const = 0;
+
+    /// Reads the options back from the kernel, which may have clamped or rounded what was requested.
+    /// Linux reports buffer sizes doubled to cover bookkeeping overhead; incoming_cpu is the CPU that last
+    /// delivered to the socket unless one was set. Fields the platform cannot report keep their defaults.
+    virtual std::expected<SocketConfig, ErrorCode> effectiveConfig() const = 0;
+
+    /// Local address the socket is bound to, e.g. the port the kernel picked for port 0.
+    virtual std::expected<Endpoint, ErrorCode> localEndpoint() const = 0;
+
     // Returns underlying socket fd/handle if needed
     virtual std::expected<int, ErrorCode> getHandle() const = 0;
 
@@ -41,4 +154,8 @@ public:
 std::expected<std::unique_ptr<Socket>, ErrorCode> Listen(const Addr& bindAddr);
 std::expected<std::unique_ptr<Socket>, ErrorCode> Dial(const Addr& remoteAddr);
 
+// Same as above with explicit options. Returns NotSupported if the chosen backend or an option is unavailable.
+std::expected<std::unique_ptr<Socket>, ErrorCode> Listen(const Addr& bindAddr, const SocketConfig& config);
+std::expected<std::unique_ptr<Socket>, ErrorCode> Dial(const Addr& remoteAddr, const SocketConfig& config);
+
 }
@@ -0,0 +1,79 @@
+#include "pulse/net/udp/endpoint.h"
+#include "pulse/net/udp/udp_addr.h"
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <cstring>
+
+#pragma comment(lib, "ws2_32.lib")
+
+namespace pulse::net::udp {
+
+Endpoint Endpoint::FromAddr(const Addr& addr) {
+    return FromSockaddr(addr.sockaddrData());
+}
+
+Endpoint Endpoint::FromSockaddr(const void* sockaddrPtr) {
+    Endpoint ep;
+    const auto* sa = static_cast<const sockaddr*>(sockaddrPtr);
+
+    if (sa->sa_family == AF_INET) {
+        const auto* a = static_cast<const sockaddr_in*>(sockaddrPtr);
+        std::memcpy(ep.bytes_, &a->sin_addr, sizeof(a->sin_addr));
+        ep.port_ = ntohs(a->sin_port);
+        ep.family_ = Family::IPv4;
+    } else if (sa->sa_family == AF_INET6) {
+        const auto* a = static_cast<const sockaddr_in6*>(sockaddrPtr);
+        std::memcpy(ep.bytes_, &a->sin6_addr, sizeof(a->sin6_addr));
+        ep.scope_id_ = a->sin6_scope_id;
+        ep.port_ = ntohs(a->sin6_port);
+        ep.family_ = Family::IPv6;
+    }
+
+    return ep;
+}
+
+size_t Endpoint::toSockaddr(void* storage) const {
+    if (family_ == Family::IPv4) {
+        auto* a = static_cast<sockaddr_in*>(storage);
+        std::memset(a, 0, sizeof(sockaddr_in));
+        a->sin_family = AF_INET;
+        a->sin_port = htons(port_);
+        std::memcpy(&a->sin_addr, bytes_, sizeof(a->sin_addr));
+        return sizeof(sockaddr_in);
+    }
+
+    if (family_ == Family::IPv6) {
+        auto* a = static_cast<sockaddr_in6*>(storage);
+        std::memset(a, 0, sizeof(sockaddr_in6));
+        a->sin6_family = AF_INET6;
+        a->sin6_port = htons(port_);
+        std::memcpy(&a->sin6_addr, bytes_, sizeof(a->sin6_addr));
+        a->sin6_scope_id = scope_id_;
+        return sizeof(sockaddr_in6);
+    }
+
+    return 0;
+}
+
+std::string Endpoint::ip() const {
+    char buf[INET6_ADDRSTRLEN] = {};
+    int af = isV4() ? AF_INET : AF_INET6;
+    if (!isSpecified() || !inet_ntop(af, bytes_, buf, sizeof(buf))) {
+        return {};
+    }
+    return buf;
+}
+
+std::string Endpoint::toString() const {
+    if (isV6()) {
+        const std::string scope = scope_id_ != 0 ? "%" + std::to_string(scope_id_) : std::string();
+        return "[" + ip() + scope + "]:" + std::to_string(port_);
+    }
+    return ip() + ":" + std::to_string(port_);
+}
+
+Addr Endpoint::toAddr() const {
+    return Addr{ip(), port_};
+}
+
+} // namespace pulse::net::udp
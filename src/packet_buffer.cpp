@@ -0,0 +1,51 @@
+#include "pulse/net/udp/packet_buffer.h"
+#include "pulse/net/udp/packet_pool.h"
+#include <utility>
+
+namespace pulse::net::udp {
+
+std::expected<PacketBuffer, ErrorCode> PacketBuffer::Create(size_t capacity) {
+    if (capacity == 0 || capacity > kMaxDatagramSize) {
+        return std::unexpected(ErrorCode::InvalidArgument);
+    }
+    return PacketBuffer(std::make_unique_for_overwrite<uint8_t[]>(capacity).release(), capacity, nullptr);
+}
+
+PacketBuffer::PacketBuffer(uint8_t* storage, size_t capacity, PacketPool* pool)
+    : storage_(storage, StorageDeleter{pool}), capacity_(capacity) {}
+
+void PacketBuffer::StorageDeleter::operator()(uint8_t* storage) const noexcept {
+    if (pool) {
+        pool->release(storage);
+    } else {
+        std::unique_ptr<uint8_t[]> owned(storage);
+    }
+}
+
+PacketBuffer::PacketBuffer(PacketBuffer&& other) noexcept
+    : storage_(std::move(other.storage_)),
+      capacity_(std::exchange(other.capacity_, 0)),
+      size_(std::exchange(other.size_, 0)),
+      addr_(other.addr_),
+      truncated_(other.truncated_) {}
+
+PacketBuffer& PacketBuffer::operator=(PacketBuffer&& other) noexcept {
+    if (this != &other) {
+        storage_ = std::move(other.storage_);
+        capacity_ = std::exchange(other.capacity_, 0);
+        size_ = std::exchange(other.size_, 0);
+        addr_ = other.addr_;
+        truncated_ = other.truncated_;
+    }
+    return *this;
+}
+
+std::expected<void, ErrorCode> PacketBuffer::resize(size_t size) {
+    if (size > capacity_) {
+        return std::unexpected(ErrorCode::InvalidArgument);
+    }
+    size_ = size;
+    return {};
+}
+
+} // namespace pulse::net::udp
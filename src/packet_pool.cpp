@@ -0,0 +1,279 @@
+#include "pulse/net/udp/packet_pool.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <unordered_set>
+#include <algorithm>
+
+namespace pulse::net::udp {
+
+namespace {
+
+constexpr size_t kMtuClass = 0;
+constexpr size_t kJumboClass = 1;
+constexpr size_t kClassCount = 2;
+
+struct ThreadCache;
+
+struct BlockHeader {
+    BlockHeader* next = nullptr;
+    ThreadCache* owner = nullptr; // cache of the thread that acquired the block; only ever compared, never dereferenced
+};
+
+struct ThreadCache {
+    BlockHeader* head[kClassCount] = {};
+    size_t count[kClassCount] = {};
+};
+
+class PacketPoolImpl;
+
+// Pools that are still alive. Thread-exit flushes take this lock so a pool cannot vanish mid-flush.
+std::mutex registryMutex;
+std::unordered_set<uint64_t> liveRegistry;
+std::atomic<uint64_t> nextPoolId{1};
+
+struct CacheSlot {
+    uint64_t pool_id;
+    PacketPoolImpl* pool;
+    std::unique_ptr<ThreadCache> cache;
+};
+
+// Per-thread list of caches, one per live pool this thread has acquired from
+struct ThreadCaches {
+    std::vector<CacheSlot> slots;
+    size_t last = 0; // slot of the most recent lookup, checked first
+    ~ThreadCaches();
+};
+
+thread_local ThreadCaches threadCaches;
+
+class PacketPoolImpl : public PacketPool {
+public:
+    explicit PacketPoolImpl(const PacketPoolConfig& config)
+        : id_(nextPoolId.fetch_add(1, std::memory_order_relaxed)),
+          thread_cache_size_(std::max<size_t>(1, config.thread_cache_size)) {
+        initClass(kMtuClass, kMtuBufferSize, config.mtu_buffers);
+        initClass(kJumboClass, kJumboBufferSize, config.jumbo_buffers);
+
+        std::lock_guard<std::mutex> lock(registryMutex);
+        liveRegistry.insert(id_);
+    }
+
+    ~PacketPoolImpl() override {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        liveRegistry.erase(id_);
+        // Threads drop their slot for this pool the next time they register a cache; the destructor cannot reach
+        // other threads' lists, and touching its own thread_local could run after it was destroyed at thread exit
+    }
+
+    std::expected<PacketBuffer, ErrorCode> acquire(size_t size) override {
+        if (size > kJumboBufferSize) {
+            return std::unexpected(ErrorCode::InvalidArgument);
+        }
+
+        const size_t cls = (size <= kMtuBufferSize) ? kMtuClass : kJumboClass;
+        auto& sc = classes_[cls];
+        ThreadCache* cache = findCache();
+        if (cache == nullptr) {
+            cache = registerCache();
+        }
+
+        if (cache->head[cls] == nullptr) {
+            refill(*cache, cls);
+        }
+
+        BlockHeader* block = cache->head[cls];
+        if (block == nullptr) {
+            sc.exhausted.fetch_add(1, std::memory_order_relaxed);
+            return std::unexpected(ErrorCode::PoolExhausted);
+        }
+
+        cache->head[cls] = block->next;
+        cache->count[cls]--;
+        block->next = nullptr;
+        block->owner = cache;
+
+        const size_t inUse = sc.in_use.fetch_add(1, std::memory_order_relaxed) + 1;
+        size_t high = sc.high_water.load(std::memory_order_relaxed);
+        while (inUse > high && !sc.high_water.compare_exchange_weak(high, inUse, std::memory_order_relaxed)) {
+        }
+
+        return wrap(sc.arena.get() + indexOf(sc, block) * sc.slab_size, sc.slab_size, this);
+    }
+
+    PacketPoolStats stats() const override {
+        const auto& mtu = classes_[kMtuClass];
+        const auto& jumbo = classes_[kJumboClass];
+        return PacketPoolStats{
+            .mtu_in_use = mtu.in_use.load(std::memory_order_relaxed),
+            .mtu_high_water = mtu.high_water.load(std::memory_order_relaxed),
+            .jumbo_in_use = jumbo.in_use.load(std::memory_order_relaxed),
+            .jumbo_high_water = jumbo.high_water.load(std::memory_order_relaxed),
+            .cross_thread_frees = cross_thread_frees_.load(std::memory_order_relaxed),
+            .exhausted = mtu.exhausted.load(std::memory_order_relaxed) + jumbo.exhausted.load(std::memory_order_relaxed)
+        };
+    }
+
+    // Returns every block a dying thread still caches to the shared lists. Caller holds registryMutex.
+    void drainCache(ThreadCache& cache) {
+        for (size_t cls = 0; cls < kClassCount; ++cls) {
+            while (BlockHeader* block = cache.head[cls]) {
+                cache.head[cls] = block->next;
+                pushShared(classes_[cls], block);
+            }
+            cache.count[cls] = 0;
+        }
+    }
+
+private:
+    struct SizeClass {
+        size_t slab_size = 0;
+        size_t slab_count = 0;
+        std::unique_ptr<uint8_t[]> arena;
+        std::unique_ptr<BlockHeader[]> headers;
+        std::atomic<BlockHeader*> shared{nullptr};
+        std::atomic<size_t> in_use{0};
+        std::atomic<size_t> high_water{0};
+        std::atomic<uint64_t> exhausted{0};
+    };
+
+    void initClass(size_t cls, size_t slabSize, size_t slabCount) {
+        auto& sc = classes_[cls];
+        sc.slab_size = slabSize;
+        sc.slab_count = slabCount;
+        if (slabCount == 0) {
+            return;
+        }
+
+        sc.arena = std::make_unique_for_overwrite<uint8_t[]>(slabSize * slabCount);
+        sc.headers = std::make_unique<BlockHeader[]>(slabCount);
+        for (size_t i = 0; i + 1 < slabCount; ++i) {
+            sc.headers[i].next = &sc.headers[i + 1];
+        }
+        sc.shared.store(&sc.headers[0], std::memory_order_release);
+    }
+
+    static size_t indexOf(const SizeClass& sc, const BlockHeader* block) {
+        return static_cast<size_t>(block - sc.headers.get());
+    }
+
+    // This thread's cache for this pool, or nullptr if it never acquired from it. Never allocates.
+    ThreadCache* findCache() const {
+        auto& caches = threadCaches;
+        if (caches.last < caches.slots.size() && caches.slots[caches.last].pool_id == id_) {
+            return caches.slots[caches.last].cache.get();
+        }
+        for (size_t i = 0; i < caches.slots.size(); ++i) {
+            if (caches.slots[i].pool_id == id_) {
+                caches.last = i;
+                return caches.slots[i].cache.get();
+            }
+        }
+        return nullptr;
+    }
+
+    // First acquire from this pool on this thread: the only allocation the pool makes after Create().
+    // Slots left behind by pools destroyed since are pruned here, so the list only holds live pools.
+    ThreadCache* registerCache() {
+        auto& caches = threadCaches;
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            std::erase_if(caches.slots, [](const CacheSlot& slot) { return !liveRegistry.contains(slot.pool_id); });
+        }
+        caches.slots.push_back(CacheSlot{id_, this, std::make_unique<ThreadCache>()});
+        caches.last = caches.slots.size() - 1;
+        return caches.slots.back().cache.get();
+    }
+
+    static void pushShared(SizeClass& sc, BlockHeader* first, BlockHeader* last) {
+        BlockHeader* head = sc.shared.load(std::memory_order_relaxed);
+        do {
+            last->next = head;
+        } while (!sc.shared.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    static void pushShared(SizeClass& sc, BlockHeader* block) {
+        pushShared(sc, block, block);
+    }
+
+    // Takes the whole shared list (pop-all is ABA-free), keeps up to thread_cache_size_ blocks and splices the rest back
+    void refill(ThreadCache& cache, size_t cls) {
+        auto& sc = classes_[cls];
+        BlockHeader* taken = sc.shared.exchange(nullptr, std::memory_order_acquire);
+        if (taken == nullptr) {
+            return;
+        }
+
+        BlockHeader* tail = taken;
+        size_t kept = 1;
+        while (kept < thread_cache_size_ && tail->next != nullptr) {
+            tail = tail->next;
+            ++kept;
+        }
+
+        if (BlockHeader* rest = tail->next) {
+            BlockHeader* restTail = rest;
+            while (restTail->next != nullptr) {
+                restTail = restTail->next;
+            }
+            pushShared(sc, rest, restTail);
+        }
+
+        tail->next = cache.head[cls];
+        cache.head[cls] = taken;
+        cache.count[cls] += kept;
+    }
+
+    void release(uint8_t* storage) noexcept override {
+        size_t cls = kMtuClass;
+        auto& jumbo = classes_[kJumboClass];
+        if (jumbo.arena && storage >= jumbo.arena.get() && storage < jumbo.arena.get() + jumbo.slab_size * jumbo.slab_count) {
+            cls = kJumboClass;
+        }
+
+        auto& sc = classes_[cls];
+        BlockHeader* block = &sc.headers[static_cast<size_t>(storage - sc.arena.get()) / sc.slab_size];
+        // A thread that never acquired from this pool has no cache; its releases go straight to the shared list
+        ThreadCache* cache = findCache();
+        const bool sameThread = cache != nullptr && block->owner == cache;
+        block->owner = nullptr;
+        sc.in_use.fetch_sub(1, std::memory_order_relaxed);
+
+        if (sameThread && cache->count[cls] < thread_cache_size_) {
+            block->next = cache->head[cls];
+            cache->head[cls] = block;
+            cache->count[cls]++;
+            return;
+        }
+
+        if (!sameThread) {
+            cross_thread_frees_.fetch_add(1, std::memory_order_relaxed);
+        }
+        pushShared(sc, block);
+    }
+
+    const uint64_t id_;
+    const size_t thread_cache_size_;
+    SizeClass classes_[kClassCount];
+    std::atomic<uint64_t> cross_thread_frees_{0};
+};
+
+ThreadCaches::~ThreadCaches() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (auto& slot : slots) {
+        if (liveRegistry.contains(slot.pool_id)) {
+            slot.pool->drainCache(*slot.cache);
+        }
+    }
+}
+
+} // namespace
+
+std::expected<std::unique_ptr<PacketPool>, ErrorCode> PacketPool::Create(const PacketPoolConfig& config) {
+    if (config.mtu_buffers == 0 && config.jumbo_buffers == 0) {
+        return std::unexpected(ErrorCode::InvalidArgument);
+    }
+    return std::make_unique<PacketPoolImpl>(config);
+}
+
+} // namespace pulse::net::udp
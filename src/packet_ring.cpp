@@ -0,0 +1,193 @@
+#include "pulse/net/udp/packet_ring.h"
+#include <algorithm>
+#include <bit>
+
+namespace pulse::net::udp {
+
+std::expected<std::unique_ptr<PacketRing>, ErrorCode> PacketRing::Create(size_t capacity, RingProducers producers) {
+    if (capacity == 0 || capacity > (size_t{1} << 30)) {
+        return std::unexpected(ErrorCode::InvalidArgument);
+    }
+    return std::unique_ptr<PacketRing>(new PacketRing(std::bit_ceil(capacity), producers));
+}
+
+PacketRing::PacketRing(size_t capacity, RingProducers producers)
+    : cells_(std::make_unique<Cell[]>(capacity)),
+      mask_(capacity - 1),
+      multi_producer_(producers == RingProducers::Multiple) {
+    for (size_t i = 0; i < capacity; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool PacketRing::tryPush(PacketBuffer& packet) {
+    uint64_t pos = tail_.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+        cell = &cells_[pos & mask_];
+        const uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<int64_t>(sequence - pos);
+        if (diff < 0) {
+            // The consumer has not freed this slot since the previous lap
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (diff == 0) {
+            if (!multi_producer_) {
+                tail_.store(pos + 1, std::memory_order_relaxed);
+                break;
+            }
+            if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+            // A failed CAS reloaded `pos`; try the slot it now points at
+        } else {
+            pos = tail_.load(std::memory_order_relaxed); // another producer claimed this slot first
+        }
+    }
+
+    cell->packet = std::move(packet);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool PacketRing::full() const {
+    const uint64_t pos = tail_.load(std::memory_order_relaxed);
+    const uint64_t sequence = cells_[pos & mask_].sequence.load(std::memory_order_acquire);
+    return static_cast<int64_t>(sequence - pos) < 0;
+}
+
+bool PacketRing::tryPop(PacketBuffer& out) {
+    return popBatch(std::span<PacketBuffer>(&out, 1)) == 1;
+}
+
+size_t PacketRing::popBatch(std::span<PacketBuffer> out) {
+    PacketBuffer* ready[kMaxRecvBatch];
+    size_t total = 0;
+    while (total < out.size()) {
+        const size_t count = peek(std::span<PacketBuffer*>(ready, std::min(out.size() - total, kMaxRecvBatch)));
+        for (size_t i = 0; i < count; ++i) {
+            out[total + i] = std::move(*ready[i]);
+        }
+        consume(count);
+        total += count;
+        if (count < kMaxRecvBatch) {
+            break;
+        }
+    }
+    return total;
+}
+
+size_t PacketRing::peek(std::span<PacketBuffer*> out) {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    size_t count = 0;
+    while (count < out.size()) {
+        Cell& cell = cells_[(head + count) & mask_];
+        if (cell.sequence.load(std::memory_order_acquire) != head + count + 1) {
+            break; // empty, or a producer has claimed the slot but not filled it yet
+        }
+        out[count++] = &cell.packet;
+    }
+
+    if (count > 0) {
+        const size_t depth = static_cast<size_t>(tail_.load(std::memory_order_relaxed) - head);
+        if (depth > high_water_.load(std::memory_order_relaxed)) {
+            high_water_.store(depth, std::memory_order_relaxed);
+        }
+    }
+    return count;
+}
+
+void PacketRing::consume(size_t count) {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        Cell& cell = cells_[(head + i) & mask_];
+        cell.packet = PacketBuffer{}; // hands pooled storage back before the slot is reused
+        // Free the slot for the push one lap ahead
+        cell.sequence.store(head + i + mask_ + 1, std::memory_order_release);
+    }
+    head_.store(head + count, std::memory_order_relaxed);
+}
+
+size_t PacketRing::size() const {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    return tail > head ? static_cast<size_t>(tail - head) : 0;
+}
+
+PacketRingStats PacketRing::stats() const {
+    return PacketRingStats{
+        .pushed = tail_.load(std::memory_order_relaxed),
+        .popped = head_.load(std::memory_order_relaxed),
+        .rejected = rejected_.load(std::memory_order_relaxed),
+        .high_water = high_water_.load(std::memory_order_relaxed)
+    };
+}
+
+std::expected<PumpReceiveResult, ErrorCode> PumpReceive(Socket& socket, PacketPool& pool, PacketRing& ring, size_t maxPackets) {
+    PumpReceiveResult result{.moved = 0, .dropped = 0};
+    while (result.moved + result.dropped < maxPackets && !ring.full()) {
+        auto buffer = pool.acquire();
+        if (!buffer) {
+            break;
+        }
+
+        auto received = socket.recvInto(*buffer);
+        if (!received) {
+            if (received.error() == ErrorCode::WouldBlock || result.moved + result.dropped > 0) {
+                break;
+            }
+            return std::unexpected(received.error());
+        }
+
+        // Only another producer can have filled the ring since full(). A slot cannot be claimed ahead of the receive
+        // without forcing every producer to publish it, so the datagram is dropped and its buffer returns to the pool
+        if (!ring.tryPush(*buffer)) {
+            result.dropped++;
+            break;
+        }
+        result.moved++;
+    }
+    return result;
+}
+
+std::expected<PumpSendResult, ErrorCode> PumpSend(PacketRing& ring, Socket& socket, size_t maxPackets) {
+    PacketBuffer* ready[kMaxSendBatch];
+    OutgoingPacket batch[kMaxSendBatch];
+    PumpSendResult result{.moved = 0, .dropped = 0};
+
+    while (result.moved + result.dropped < maxPackets) {
+        const size_t count = ring.peek(std::span<PacketBuffer*>(ready, std::min(maxPackets - result.moved - result.dropped, kMaxSendBatch)));
+        if (count == 0) {
+            break;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            batch[i] = OutgoingPacket{.addr = ready[i]->addr(), .data = ready[i]->data(), .length = ready[i]->size()};
+        }
+
+        auto sent = socket.sendBatch(std::span<const OutgoingPacket>(batch, count));
+        if (!sent) {
+            if (sent.error() == ErrorCode::WouldBlock) {
+                break;
+            }
+            if (sent.error() == ErrorCode::InvalidSocket) {
+                if (result.moved + result.dropped == 0) {
+                    return std::unexpected(sent.error());
+                }
+                break;
+            }
+            ring.consume(1); // refused outright; skip it
+            result.dropped++;
+            continue;
+        }
+
+        ring.consume(*sent);
+        result.moved += *sent;
+        if (*sent < count) {
+            break; // socket buffer full
+        }
+    }
+    return result;
+}
+
+} // namespace pulse::net::udp
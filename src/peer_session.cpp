@@ -0,0 +1,51 @@
+#include "pulse/net/udp/peer_session.h"
+#include <algorithm>
+
+namespace pulse::net::udp {
+
+// PeerSession::Open() lives with the platform socket code; only the send paths are shared
+
+std::expected<void, ErrorCode> PeerSession::send(const uint8_t* data, size_t length) {
+    if (connected_) {
+        return connected_->send(data, length);
+    }
+    return listener_->sendTo(peer_, data, length);
+}
+
+std::expected<size_t, ErrorCode> PeerSession::sendBatch(std::span<const OutgoingPacket> packets) {
+    // Connected sockets take an unspecified address to mean the connected peer
+    const Endpoint target = connected_ ? Endpoint{} : peer_;
+    Socket& socket = connected_ ? *connected_ : *listener_;
+
+    OutgoingPacket batch[kMaxSendBatch];
+    size_t accepted = 0;
+    while (accepted < packets.size()) {
+        const size_t count = std::min(packets.size() - accepted, kMaxSendBatch);
+        for (size_t i = 0; i < count; ++i) {
+            batch[i] = OutgoingPacket{.addr = target, .data = packets[accepted + i].data, .length = packets[accepted + i].length};
+        }
+
+        auto sent = socket.sendBatch(std::span<const OutgoingPacket>(batch, count));
+        if (!sent) {
+            if (accepted == 0) {
+                return std::unexpected(sent.error());
+            }
+            break;
+        }
+
+        accepted += *sent;
+        if (*sent < count) {
+            break;
+        }
+    }
+    return accepted;
+}
+
+std::expected<size_t, ErrorCode> PeerSession::sendSegmented(const uint8_t* data, size_t length, size_t segmentSize) {
+    if (connected_) {
+        return connected_->sendSegmented(Endpoint{}, data, length, segmentSize);
+    }
+    return listener_->sendSegmented(peer_, data, length, segmentSize);
+}
+
+} // namespace pulse::net::udp
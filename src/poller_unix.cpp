@@ -0,0 +1,264 @@
+#include "pulse/net/udp/poller.h"
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <ctime>
+#include <climits>
+#include <vector>
+#include <unordered_map>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#endif
+
+namespace pulse::net::udp {
+
+namespace {
+
+// Millisecond timeout for poll()/epoll_wait(), rounded up so we never wake before the deadline
+int toPollTimeoutMs(uint64_t timeout_ns) {
+    if (timeout_ns == kWaitForever) {
+        return -1;
+    }
+    const uint64_t ms = (timeout_ns + 999'999) / 1'000'000;
+    return ms > static_cast<uint64_t>(INT_MAX) ? INT_MAX : static_cast<int>(ms);
+}
+
+} // namespace
+
+#if defined(__linux__)
+
+class PollerEpoll : public Poller {
+public:
+    explicit PollerEpoll(int epfd) : epfd_(epfd) {}
+
+    ~PollerEpoll() override {
+        ::close(epfd_);
+    }
+
+    std::expected<void, ErrorCode> add(Socket& socket, uint64_t token, PollInterest interest) override {
+        auto handle = socket.getHandle();
+        if (!handle) {
+            return std::unexpected(handle.error());
+        }
+
+        if (registrations_.contains(&socket)) {
+            return std::unexpected(ErrorCode::InvalidArgument);
+        }
+
+        auto reg = std::make_unique<Registration>(Registration{&socket, token, *handle});
+        epoll_event ev{};
+        ev.events = toEpollEvents(interest);
+        ev.data.ptr = reg.get();
+        if (::epoll_ctl(epfd_, EPOLL_CTL_ADD, *handle, &ev) < 0) {
+            return std::unexpected(ErrorCode::PollFailed);
+        }
+
+        registrations_.emplace(&socket, std::move(reg));
+        return {};
+    }
+
+    std::expected<void, ErrorCode> modify(Socket& socket, PollInterest interest) override {
+        auto it = registrations_.find(&socket);
+        if (it == registrations_.end()) {
+            return std::unexpected(ErrorCode::InvalidArgument);
+        }
+
+        epoll_event ev{};
+        ev.events = toEpollEvents(interest);
+        ev.data.ptr = it->second.get();
+        if (::epoll_ctl(epfd_, EPOLL_CTL_MOD, it->second->fd, &ev) < 0) {
+            return std::unexpected(ErrorCode::PollFailed);
+        }
+        return {};
+    }
+
+    std::expected<void, ErrorCode> remove(Socket& socket) override {
+        auto it = registrations_.find(&socket);
+        if (it == registrations_.end()) {
+            return std::unexpected(ErrorCode::InvalidArgument);
+        }
+
+        // Closing the socket already dropped it from the epoll set, so a failed DEL is expected then;
+        // if the fd was reused meanwhile, epoll matches on the open file and leaves the newcomer alone
+        ::epoll_ctl(epfd_, EPOLL_CTL_DEL, it->second->fd, nullptr);
+        registrations_.erase(it);
+        return {};
+    }
+
+    std::expected<std::span<const PollEvent>, ErrorCode> wait(uint64_t timeout_ns) override {
+        if (registrations_.empty() && timeout_ns == kWaitForever) {
+            return std::unexpected(ErrorCode::InvalidArgument); // nothing could ever end the wait
+        }
+
+        epoll_event ready[kMaxPollEvents];
+        int n = waitEpoll(ready, timeout_ns);
+        if (n < 0) {
+            if (errno == EINTR) {
+                return std::span<const PollEvent>{};
+            }
+            return std::unexpected(ErrorCode::PollFailed);
+        }
+
+        for (int i = 0; i < n; ++i) {
+            const auto* reg = static_cast<const Registration*>(ready[i].data.ptr);
+            events_[i] = PollEvent{
+                .socket = reg->socket,
+                .token = reg->token,
+                .readable = (ready[i].events & EPOLLIN) != 0,
+                .writable = (ready[i].events & EPOLLOUT) != 0,
+                .error = (ready[i].events & (EPOLLERR | EPOLLHUP)) != 0
+            };
+        }
+
+        return std::span<const PollEvent>(events_, static_cast<size_t>(n));
+    }
+
+private:
+    struct Registration {
+        Socket* socket;
+        uint64_t token;
+        int fd; // captured at add() so modify()/remove() still work once the socket is closed
+    };
+
+    static uint32_t toEpollEvents(PollInterest interest) {
+        return (interest.readable ? EPOLLIN : 0u) | (interest.writable ? EPOLLOUT : 0u);
+    }
+
+    int waitEpoll(epoll_event* ready, uint64_t timeout_ns) {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 35))
+        // epoll_pwait2() takes a timespec, so sub-millisecond timeouts are honoured (Linux 5.11+)
+        if (has_pwait2_ && timeout_ns != kWaitForever) {
+            timespec ts{
+                .tv_sec = static_cast<time_t>(timeout_ns / 1'000'000'000),
+                .tv_nsec = static_cast<long>(timeout_ns % 1'000'000'000)
+            };
+            int n = ::epoll_pwait2(epfd_, ready, static_cast<int>(kMaxPollEvents), &ts, nullptr);
+            if (n >= 0 || errno != ENOSYS) {
+                return n;
+            }
+            has_pwait2_ = false;
+        }
+#endif
+        return ::epoll_wait(epfd_, ready, static_cast<int>(kMaxPollEvents), toPollTimeoutMs(timeout_ns));
+    }
+
+    int epfd_;
+    bool has_pwait2_ = true;
+    std::unordered_map<Socket*, std::unique_ptr<Registration>> registrations_;
+    PollEvent events_[kMaxPollEvents];
+};
+
+std::expected<std::unique_ptr<Poller>, ErrorCode> Poller::Create() {
+    int epfd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (epfd < 0) {
+        return std::unexpected(ErrorCode::PollFailed);
+    }
+    return std::make_unique<PollerEpoll>(epfd);
+}
+
+#else
+
+class PollerPosix : public Poller {
+public:
+    std::expected<void, ErrorCode> add(Socket& socket, uint64_t token, PollInterest interest) override {
+        auto handle = socket.getHandle();
+        if (!handle) {
+            return std::unexpected(handle.error());
+        }
+
+        if (findIndex(&socket) != npos) {
+            return std::unexpected(ErrorCode::InvalidArgument);
+        }
+
+        fds_.push_back(pollfd{*handle, toPollEvents(interest), 0});
+        registrations_.push_back(Registration{&socket, token});
+        return {};
+    }
+
+    std::expected<void, ErrorCode> modify(Socket& socket, PollInterest interest) override {
+        size_t index = findIndex(&socket);
+        if (index == npos) {
+            return std::unexpected(ErrorCode::InvalidArgument);
+        }
+
+        fds_[index].events = toPollEvents(interest);
+        return {};
+    }
+
+    std::expected<void, ErrorCode> remove(Socket& socket) override {
+        size_t index = findIndex(&socket);
+        if (index == npos) {
+            return std::unexpected(ErrorCode::InvalidArgument);
+        }
+
+        fds_.erase(fds_.begin() + static_cast<std::ptrdiff_t>(index));
+        registrations_.erase(registrations_.begin() + static_cast<std::ptrdiff_t>(index));
+        return {};
+    }
+
+    std::expected<std::span<const PollEvent>, ErrorCode> wait(uint64_t timeout_ns) override {
+        if (fds_.empty() && timeout_ns == kWaitForever) {
+            return std::unexpected(ErrorCode::InvalidArgument); // nothing could ever end the wait
+        }
+
+        int n = ::poll(fds_.data(), static_cast<nfds_t>(fds_.size()), toPollTimeoutMs(timeout_ns));
+        if (n < 0) {
+            if (errno == EINTR) {
+                return std::span<const PollEvent>{};
+            }
+            return std::unexpected(ErrorCode::PollFailed);
+        }
+
+        size_t count = 0;
+        for (size_t i = 0; i < fds_.size() && count < kMaxPollEvents; ++i) {
+            const short revents = fds_[i].revents;
+            if (revents == 0) {
+                continue;
+            }
+            events_[count++] = PollEvent{
+                .socket = registrations_[i].socket,
+                .token = registrations_[i].token,
+                .readable = (revents & POLLIN) != 0,
+                .writable = (revents & POLLOUT) != 0,
+                .error = (revents & (POLLERR | POLLHUP | POLLNVAL)) != 0
+            };
+        }
+
+        return std::span<const PollEvent>(events_, count);
+    }
+
+private:
+    struct Registration {
+        Socket* socket;
+        uint64_t token;
+    };
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    static short toPollEvents(PollInterest interest) {
+        return static_cast<short>((interest.readable ? POLLIN : 0) | (interest.writable ? POLLOUT : 0));
+    }
+
+    // Looked up by socket rather than fd, so a closed socket can still be removed and its fd reused
+    size_t findIndex(const Socket* socket) const {
+        for (size_t i = 0; i < registrations_.size(); ++i) {
+            if (registrations_[i].socket == socket) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    std::vector<pollfd> fds_;
+    std::vector<Registration> registrations_;
+    PollEvent events_[kMaxPollEvents];
+};
+
+std::expected<std::unique_ptr<Poller>, ErrorCode> Poller::Create() {
+    return std::make_unique<PollerPosix>();
+}
+
+#endif
+
+} // namespace pulse::net::udp
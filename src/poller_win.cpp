@@ -0,0 +1,128 @@
+#include "pulse/net/udp/poller.h"
+#include <winsock2.h>
+#include <windows.h>
+#include <climits>
+#include <vector>
+
+#pragma comment(lib, "ws2_32.lib")
+
+namespace pulse::net::udp {
+
+namespace {
+
+// Millisecond timeout for WSAPoll(), rounded up so we never wake before the deadline
+int toPollTimeoutMs(uint64_t timeout_ns) {
+    if (timeout_ns == kWaitForever) {
+        return -1;
+    }
+    const uint64_t ms = (timeout_ns + 999'999) / 1'000'000;
+    return ms > static_cast<uint64_t>(INT_MAX) ? INT_MAX : static_cast<int>(ms);
+}
+
+} // namespace
+
+class PollerWindows : public Poller {
+public:
+    std::expected<void, ErrorCode> add(Socket& socket, uint64_t token, PollInterest interest) override {
+        auto handle = socket.getHandle();
+        if (!handle) {
+            return std::unexpected(handle.error());
+        }
+
+        if (findIndex(&socket) != npos) {
+            return std::unexpected(ErrorCode::InvalidArgument);
+        }
+
+        fds_.push_back(WSAPOLLFD{static_cast<SOCKET>(*handle), toPollEvents(interest), 0});
+        registrations_.push_back(Registration{&socket, token});
+        return {};
+    }
+
+    std::expected<void, ErrorCode> modify(Socket& socket, PollInterest interest) override {
+        size_t index = findIndex(&socket);
+        if (index == npos) {
+            return std::unexpected(ErrorCode::InvalidArgument);
+        }
+
+        fds_[index].events = toPollEvents(interest);
+        return {};
+    }
+
+    std::expected<void, ErrorCode> remove(Socket& socket) override {
+        size_t index = findIndex(&socket);
+        if (index == npos) {
+            return std::unexpected(ErrorCode::InvalidArgument);
+        }
+
+        fds_.erase(fds_.begin() + static_cast<std::ptrdiff_t>(index));
+        registrations_.erase(registrations_.begin() + static_cast<std::ptrdiff_t>(index));
+        return {};
+    }
+
+    std::expected<std::span<const PollEvent>, ErrorCode> wait(uint64_t timeout_ns) override {
+        if (fds_.empty()) {
+            // WSAPoll() rejects an empty set; emulate the timeout instead. Nothing could ever end an infinite wait
+            if (timeout_ns == kWaitForever) {
+                return std::unexpected(ErrorCode::InvalidArgument);
+            }
+            if (timeout_ns != 0) {
+                ::Sleep(static_cast<DWORD>(toPollTimeoutMs(timeout_ns)));
+            }
+            return std::span<const PollEvent>{};
+        }
+
+        int n = ::WSAPoll(fds_.data(), static_cast<ULONG>(fds_.size()), toPollTimeoutMs(timeout_ns));
+        if (n == SOCKET_ERROR) {
+            return std::unexpected(ErrorCode::PollFailed);
+        }
+
+        size_t count = 0;
+        for (size_t i = 0; i < fds_.size() && count < kMaxPollEvents; ++i) {
+            const short revents = fds_[i].revents;
+            if (revents == 0) {
+                continue;
+            }
+            events_[count++] = PollEvent{
+                .socket = registrations_[i].socket,
+                .token = registrations_[i].token,
+                .readable = (revents & POLLIN) != 0,
+                .writable = (revents & POLLOUT) != 0,
+                .error = (revents & (POLLERR | POLLHUP | POLLNVAL)) != 0
+            };
+        }
+
+        return std::span<const PollEvent>(events_, count);
+    }
+
+private:
+    struct Registration {
+        Socket* socket;
+        uint64_t token;
+    };
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    static short toPollEvents(PollInterest interest) {
+        return static_cast<short>((interest.readable ? POLLIN : 0) | (interest.writable ? POLLOUT : 0));
+    }
+
+    // Looked up by socket rather than fd, so a closed socket can still be removed and its fd reused
+    size_t findIndex(const Socket* socket) const {
+        for (size_t i = 0; i < registrations_.size(); ++i) {
+            if (registrations_[i].socket == socket) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    std::vector<WSAPOLLFD> fds_;
+    std::vector<Registration> registrations_;
+    PollEvent events_[kMaxPollEvents];
+};
+
+std::expected<std::unique_ptr<Poller>, ErrorCode> Poller::Create() {
+    return std::make_unique<PollerWindows>();
+}
+
+} // namespace pulse::net::udp
@@ -0,0 +1,341 @@
+#include "pulse/net/udp/reactor.h"
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace pulse::net::udp {
+
+// Poller tokens carry the slot index in the low half and its generation in the high half,
+// so readiness for a socket detached earlier in the same wait() is recognised and ignored
+static uint64_t makeToken(uint32_t slot, uint32_t generation) {
+    return (static_cast<uint64_t>(generation) << 32) | slot;
+}
+
+static uint64_t deadlineAfter(uint64_t timeoutNs) {
+    const uint64_t now = Reactor::now();
+    return timeoutNs > UINT64_MAX - now ? UINT64_MAX : now + timeoutNs;
+}
+
+// Orders the timer heap so the earliest deadline is at the front
+static constexpr auto LATER = [](const auto& lhs, const auto& rhs) { return lhs.deadline_ns > rhs.deadline_ns; };
+
+uint64_t Reactor::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+std::expected<std::unique_ptr<Reactor>, ErrorCode> Reactor::Create() {
+    auto poller = Poller::Create();
+    if (!poller) {
+        return std::unexpected(poller.error());
+    }
+    return std::unique_ptr<Reactor>(new Reactor(std::move(*poller)));
+}
+
+Reactor::Reactor(std::unique_ptr<Poller> poller) : poller_(std::move(poller)) {}
+
+Reactor::~Reactor() {
+    // Task frames may still hold AsyncSockets, which detach from this reactor as they are destroyed
+    roots_.clear();
+}
+
+void Reactor::spawn(Task<void> task) {
+    auto handle = task.handle_;
+    if (!handle) {
+        return;
+    }
+    roots_.push_back(std::move(task));
+    handle.resume();
+}
+
+std::expected<size_t, ErrorCode> Reactor::runOnce(uint64_t timeoutNs) {
+    uint64_t waitNs = timeoutNs;
+    if (!timers_.empty()) {
+        const uint64_t now = Reactor::now();
+        waitNs = std::min(waitNs, timers_.front().deadline_ns > now ? timers_.front().deadline_ns - now : 0);
+    }
+
+    auto events = poller_->wait(waitNs);
+    if (!events) {
+        return std::unexpected(events.error());
+    }
+
+    // Complete every wait first and resume afterwards: a resumed coroutine may detach sockets that later events name
+    for (const PollEvent& event : *events) {
+        const auto index = static_cast<uint32_t>(event.token);
+        if (index >= slots_.size() || slots_[index].socket == nullptr ||
+            slots_[index].generation != static_cast<uint32_t>(event.token >> 32)) {
+            continue;
+        }
+
+        SocketSlot& slot = slots_[index];
+        if ((event.readable || event.error) && slot.reader && slot.reader->attempt()) {
+            runnable_.push_back(slot.reader->handle);
+            slot.reader = nullptr;
+        }
+        if ((event.writable || event.error) && slot.writer && slot.writer->attempt()) {
+            runnable_.push_back(slot.writer->handle);
+            slot.writer = nullptr;
+        }
+        if (event.error && !slot.reader && !slot.writer) {
+            // Errors are reported whatever the interest, so a pending one (say an ICMP port unreachable) with nobody
+            // waiting would end every wait() at once. Unregister until a coroutine parks; its first attempt collects it.
+            (void)poller_->remove(*slot.socket);
+            slot.registered = false;
+            slot.interest = PollInterest{.readable = false, .writable = false};
+            continue;
+        }
+        updateInterest(index);
+    }
+    expireTimers();
+
+    const size_t resumed = runnable_.size();
+    for (size_t i = 0; i < runnable_.size(); ++i) {
+        runnable_[i].resume();
+    }
+    runnable_.clear();
+
+    std::erase_if(roots_, [](const Task<void>& task) { return task.done(); });
+    return resumed;
+}
+
+std::expected<void, ErrorCode> Reactor::run() {
+    std::erase_if(roots_, [](const Task<void>& task) { return task.done(); });
+    while (!roots_.empty()) {
+        if (auto ran = runOnce(kWaitForever); !ran) {
+            return std::unexpected(ran.error());
+        }
+    }
+    return {};
+}
+
+size_t Reactor::tasks() const {
+    return static_cast<size_t>(std::count_if(roots_.begin(), roots_.end(), [](const Task<void>& task) { return !task.done(); }));
+}
+
+SleepAwaiter Reactor::sleepFor(uint64_t durationNs) {
+    return SleepAwaiter(*this, deadlineAfter(durationNs));
+}
+
+SleepAwaiter Reactor::sleepUntil(uint64_t deadlineNs) {
+    return SleepAwaiter(*this, deadlineNs);
+}
+
+std::expected<uint32_t, ErrorCode> Reactor::attach(Socket& socket) {
+    uint32_t index;
+    if (!free_slots_.empty()) {
+        index = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back();
+    }
+
+    SocketSlot& slot = slots_[index];
+    // Registered with no interest; it is switched on only while a coroutine waits, since readiness is level-triggered
+    if (auto added = poller_->add(socket, makeToken(index, slot.generation), PollInterest{.readable = false, .writable = false}); !added) {
+        free_slots_.push_back(index);
+        return std::unexpected(added.error());
+    }
+    slot.socket = &socket;
+    slot.interest = PollInterest{.readable = false, .writable = false};
+    slot.registered = true;
+    return index;
+}
+
+void Reactor::detach(uint32_t index) {
+    SocketSlot& slot = slots_[index];
+    if (slot.registered) {
+        (void)poller_->remove(*slot.socket);
+    }
+    slot = SocketSlot{.generation = slot.generation + 1};
+    free_slots_.push_back(index);
+}
+
+std::expected<void, ErrorCode> Reactor::park(uint32_t index, detail::IoWaiter& waiter, bool write, uint64_t timeoutNs) {
+    if (timeoutNs == 0) {
+        return std::unexpected(ErrorCode::Timeout);
+    }
+
+    SocketSlot& slot = slots_[index];
+    detail::IoWaiter*& current = write ? slot.writer : slot.reader;
+    if (current != nullptr) {
+        return std::unexpected(ErrorCode::InvalidArgument);
+    }
+
+    waiter.seq = next_seq_++;
+    current = &waiter;
+    updateInterest(index);
+    if (timeoutNs != kWaitForever) {
+        addTimer(Timer{
+            .deadline_ns = deadlineAfter(timeoutNs),
+            .seq = waiter.seq,
+            .sleeper = {},
+            .slot = index,
+            .generation = slot.generation,
+            .write = write
+        });
+    }
+    return {};
+}
+
+void Reactor::addTimer(const Timer& timer) {
+    timers_.push_back(timer);
+    std::push_heap(timers_.begin(), timers_.end(), LATER);
+}
+
+void Reactor::updateInterest(uint32_t index) {
+    SocketSlot& slot = slots_[index];
+    const PollInterest wanted{.readable = slot.reader != nullptr, .writable = slot.writer != nullptr};
+    if (!slot.registered) {
+        if ((wanted.readable || wanted.writable) && poller_->add(*slot.socket, makeToken(index, slot.generation), wanted)) {
+            slot.registered = true;
+            slot.interest = wanted;
+        }
+        return;
+    }
+    if (wanted.readable != slot.interest.readable || wanted.writable != slot.interest.writable) {
+        if (poller_->modify(*slot.socket, wanted)) {
+            slot.interest = wanted;
+        }
+    }
+}
+
+void Reactor::expireTimers() {
+    const uint64_t now = Reactor::now();
+    while (!timers_.empty() && timers_.front().deadline_ns <= now) {
+        std::pop_heap(timers_.begin(), timers_.end(), LATER);
+        const Timer timer = timers_.back();
+        timers_.pop_back();
+
+        if (timer.sleeper) {
+            runnable_.push_back(timer.sleeper);
+            continue;
+        }
+
+        // An I/O timeout is stale once its wait completed, or the socket was detached, before the deadline
+        if (timer.slot >= slots_.size() || slots_[timer.slot].socket == nullptr || slots_[timer.slot].generation != timer.generation) {
+            continue;
+        }
+        SocketSlot& slot = slots_[timer.slot];
+        detail::IoWaiter*& waiter = timer.write ? slot.writer : slot.reader;
+        if (waiter == nullptr || waiter->seq != timer.seq) {
+            continue;
+        }
+        waiter->expire();
+        runnable_.push_back(waiter->handle);
+        waiter = nullptr;
+        updateInterest(timer.slot);
+    }
+}
+
+bool SleepAwaiter::await_ready() const {
+    return deadline_ns_ <= Reactor::now();
+}
+
+void SleepAwaiter::await_suspend(std::coroutine_handle<> awaiting) const {
+    reactor_->addTimer(Reactor::Timer{
+        .deadline_ns = deadline_ns_,
+        .seq = 0,
+        .sleeper = awaiting,
+        .slot = 0,
+        .generation = 0,
+        .write = false
+    });
+}
+
+bool RecvAwaiter::await_ready() {
+    return attempt();
+}
+
+bool RecvAwaiter::await_suspend(std::coroutine_handle<> awaiting) {
+    handle = awaiting;
+    if (auto parked = reactor_->park(slot_, *this, false, timeout_ns_); !parked) {
+        result_ = std::unexpected(parked.error());
+        return false; // resume straight away with the error
+    }
+    return true;
+}
+
+bool RecvAwaiter::attempt() {
+    result_ = socket_->recvFrom(buffer_);
+    return result_ || result_.error() != ErrorCode::WouldBlock;
+}
+
+void RecvAwaiter::expire() {
+    result_ = std::unexpected(ErrorCode::Timeout);
+}
+
+bool SendAwaiter::await_ready() {
+    return attempt();
+}
+
+bool SendAwaiter::await_suspend(std::coroutine_handle<> awaiting) {
+    handle = awaiting;
+    if (auto parked = reactor_->park(slot_, *this, true, timeout_ns_); !parked) {
+        result_ = std::unexpected(parked.error());
+        return false;
+    }
+    return true;
+}
+
+bool SendAwaiter::attempt() {
+    result_ = addr_.isSpecified() ? socket_->sendTo(addr_, data_, length_) : socket_->send(data_, length_);
+    return result_ || result_.error() != ErrorCode::WouldBlock;
+}
+
+void SendAwaiter::expire() {
+    result_ = std::unexpected(ErrorCode::Timeout);
+}
+
+std::expected<AsyncSocket, ErrorCode> AsyncSocket::Attach(Reactor& reactor, Socket& socket, size_t bufferSize) {
+    if (bufferSize == 0 || bufferSize > kMaxDatagramSize) {
+        return std::unexpected(ErrorCode::InvalidArgument);
+    }
+    auto slot = reactor.attach(socket);
+    if (!slot) {
+        return std::unexpected(slot.error());
+    }
+    return AsyncSocket(reactor, *slot, socket, std::make_unique_for_overwrite<uint8_t[]>(bufferSize), bufferSize);
+}
+
+AsyncSocket::AsyncSocket(AsyncSocket&& other) noexcept
+    : reactor_(std::exchange(other.reactor_, nullptr)),
+      slot_(other.slot_),
+      socket_(other.socket_),
+      buffer_(std::move(other.buffer_)),
+      buffer_size_(other.buffer_size_) {}
+
+AsyncSocket& AsyncSocket::operator=(AsyncSocket&& other) noexcept {
+    if (this != &other) {
+        if (reactor_) {
+            reactor_->detach(slot_);
+        }
+        reactor_ = std::exchange(other.reactor_, nullptr);
+        slot_ = other.slot_;
+        socket_ = other.socket_;
+        buffer_ = std::move(other.buffer_);
+        buffer_size_ = other.buffer_size_;
+    }
+    return *this;
+}
+
+AsyncSocket::~AsyncSocket() {
+    if (reactor_) {
+        reactor_->detach(slot_);
+    }
+}
+
+RecvAwaiter AsyncSocket::recv(uint64_t timeoutNs) {
+    return RecvAwaiter(*reactor_, slot_, *socket_, std::span<uint8_t>(buffer_.get(), buffer_size_), timeoutNs);
+}
+
+SendAwaiter AsyncSocket::sendTo(const Endpoint& addr, const uint8_t* data, size_t length, uint64_t timeoutNs) {
+    return SendAwaiter(*reactor_, slot_, *socket_, addr, data, length, timeoutNs);
+}
+
+SendAwaiter AsyncSocket::send(const uint8_t* data, size_t length, uint64_t timeoutNs) {
+    return SendAwaiter(*reactor_, slot_, *socket_, Endpoint{}, data, length, timeoutNs);
+}
+
+} // namespace pulse::net::udp
@@ -0,0 +1,128 @@
+#include "pulse/net/udp/receive_driver.h"
+#include <algorithm>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+namespace pulse::net::udp {
+
+// Weight of the newest gap in the running average, as a shift: 1/8
+static constexpr unsigned GAP_EWMA_SHIFT = 3;
+
+static uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Tells the core we are spinning so it can ease off the sibling hyperthread and the memory bus
+static inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+static uint64_t countOf(const std::expected<ReceivedPacket, ErrorCode>&) { return 1; }
+static uint64_t countOf(const std::expected<size_t, ErrorCode>& received) { return *received; }
+
+std::expected<ReceiveDriver, ErrorCode> ReceiveDriver::Create(Socket& socket, const ReceiveDriverConfig& config) {
+    if (config.spin_multiplier == 0 || config.min_spin_ns > config.max_spin_ns) {
+        return std::unexpected(ErrorCode::InvalidArgument);
+    }
+
+    auto poller = Poller::Create();
+    if (!poller) {
+        return std::unexpected(poller.error());
+    }
+    if (auto added = (*poller)->add(socket, 0); !added) {
+        return std::unexpected(added.error());
+    }
+    return ReceiveDriver(socket, std::move(*poller), config);
+}
+
+ReceiveDriver::ReceiveDriver(Socket& socket, std::unique_ptr<Poller> poller, const ReceiveDriverConfig& config)
+    : socket_(&socket), poller_(std::move(poller)), config_(config), spin_budget_ns_(config.min_spin_ns) {}
+
+std::expected<ReceivedPacket, ErrorCode> ReceiveDriver::next(uint64_t timeoutNs) {
+    return drive([this] { return socket_->recvFrom(); }, timeoutNs);
+}
+
+std::expected<size_t, ErrorCode> ReceiveDriver::nextBatch(std::span<ReceivedPacket> packets, uint64_t timeoutNs) {
+    return drive([this, packets] { return socket_->recvBatch(packets); }, timeoutNs);
+}
+
+ReceiveDriverStats ReceiveDriver::stats() const {
+    ReceiveDriverStats stats = stats_;
+    stats.avg_gap_ns = avg_gap_ns_;
+    stats.spin_budget_ns = spin_budget_ns_;
+    return stats;
+}
+
+template <typename Receive>
+auto ReceiveDriver::drive(Receive&& receive, uint64_t timeoutNs) -> decltype(receive()) {
+    auto result = receive();
+    if (result || result.error() != ErrorCode::WouldBlock) {
+        if (result) {
+            arrived(nowNs(), countOf(result));
+        }
+        return result;
+    }
+
+    const uint64_t start = nowNs();
+    const uint64_t deadline = (timeoutNs == kWaitForever || timeoutNs > UINT64_MAX - start) ? UINT64_MAX : start + timeoutNs;
+    const uint64_t spinUntil = std::min(deadline, start + spin_budget_ns_);
+
+    uint64_t now = start;
+    while (now < spinUntil) {
+        cpuRelax();
+        result = receive();
+        now = nowNs();
+        if (result) {
+            stats_.spun += countOf(result);
+            arrived(now, countOf(result));
+            return result;
+        }
+        if (result.error() != ErrorCode::WouldBlock) {
+            return result;
+        }
+    }
+
+    while (now < deadline) {
+        stats_.parked++;
+        auto ready = poller_->wait(deadline == UINT64_MAX ? kWaitForever : deadline - now);
+        if (!ready) {
+            return std::unexpected(ready.error());
+        }
+
+        // Level-triggered readiness can still race another reader; an empty receive just parks again
+        result = receive();
+        now = nowNs();
+        if (result) {
+            arrived(now, countOf(result));
+            return result;
+        }
+        if (result.error() != ErrorCode::WouldBlock) {
+            return result;
+        }
+    }
+    return std::unexpected(ErrorCode::Timeout);
+}
+
+void ReceiveDriver::arrived(uint64_t arrivalNs, uint64_t count) {
+    stats_.received += count;
+    if (last_arrival_ns_ != 0 && count > 0) {
+        // Clamp idle stretches so one quiet period is forgotten within a few arrivals once traffic resumes;
+        // anything past twice the spin cap already means "too sparse to spin for"
+        const uint64_t gap = std::min(arrivalNs - last_arrival_ns_, 2 * config_.max_spin_ns) / count;
+        avg_gap_ns_ = avg_gap_ns_ - (avg_gap_ns_ >> GAP_EWMA_SHIFT) + (gap >> GAP_EWMA_SHIFT);
+
+        const uint64_t target = avg_gap_ns_ * config_.spin_multiplier;
+        spin_budget_ns_ = target <= config_.max_spin_ns ? std::max(target, config_.min_spin_ns) : config_.min_spin_ns;
+    }
+    last_arrival_ns_ = arrivalNs;
+}
+
+} // namespace pulse::net::udp
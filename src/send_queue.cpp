@@ -0,0 +1,140 @@
+#include "pulse/net/udp/send_queue.h"
+#include <cstring>
+
+namespace pulse::net::udp {
+
+// Fewer datagrams than this in a run are cheaper to leave in the sendBatch() stretch around them
+static constexpr size_t MIN_SEGMENT_RUN = 2;
+
+std::expected<SendQueue, ErrorCode> SendQueue::Create(Socket& socket, const SendQueueConfig& config) {
+    if (config.max_datagrams == 0 || config.max_bytes == 0) {
+        return std::unexpected(ErrorCode::InvalidArgument);
+    }
+    return SendQueue(socket, config);
+}
+
+SendQueue::SendQueue(Socket& socket, const SendQueueConfig& config)
+    : socket_(&socket),
+      entries_(std::make_unique_for_overwrite<Entry[]>(config.max_datagrams)),
+      bytes_(std::make_unique_for_overwrite<uint8_t[]>(config.max_bytes)),
+      max_datagrams_(config.max_datagrams),
+      max_bytes_(config.max_bytes) {}
+
+std::expected<void, ErrorCode> SendQueue::push(const Endpoint& addr, const uint8_t* data, size_t length) {
+    if (length > kMaxDatagramSize) {
+        return std::unexpected(ErrorCode::InvalidArgument);
+    }
+    if (count_ == max_datagrams_ || length > max_bytes_ - bytes_used_) {
+        return std::unexpected(ErrorCode::PoolExhausted);
+    }
+
+    // Payloads are appended back to back, so consecutive datagrams to one peer already form a GSO buffer
+    if (length > 0) {
+        std::memcpy(&bytes_[bytes_used_], data, length);
+    }
+    entries_[count_++] = Entry{.addr = addr, .offset = bytes_used_, .length = length};
+    bytes_used_ += length;
+    return {};
+}
+
+std::expected<size_t, ErrorCode> SendQueue::flush() {
+    size_t done = 0; // leading entries sent or dropped
+    size_t sentNow = 0;
+
+    while (done < count_) {
+        const size_t run = segmentRun(done);
+        size_t attempted = 0;
+        std::expected<size_t, ErrorCode> sent;
+
+        if (run >= MIN_SEGMENT_RUN) {
+            const Entry& first = entries_[done];
+            const Entry& last = entries_[done + run - 1];
+            attempted = run;
+            sent = socket_->sendSegmented(first.addr, &bytes_[first.offset], last.offset + last.length - first.offset, first.length);
+        } else {
+            // Everything up to the next run goes down in one sendBatch()
+            OutgoingPacket batch[kMaxSendBatch];
+            for (size_t i = done; i < count_ && attempted < kMaxSendBatch; ++i) {
+                if (attempted > 0 && segmentRun(i) >= MIN_SEGMENT_RUN) {
+                    break;
+                }
+                batch[attempted++] = OutgoingPacket{.addr = entries_[i].addr, .data = &bytes_[entries_[i].offset], .length = entries_[i].length};
+            }
+            sent = socket_->sendBatch(std::span<const OutgoingPacket>(batch, attempted));
+        }
+
+        if (!sent) {
+            if (sent.error() == ErrorCode::WouldBlock) {
+                stats_.deferred++;
+                break;
+            }
+            if (sent.error() == ErrorCode::InvalidSocket) {
+                consume(done);
+                return std::unexpected(sent.error());
+            }
+            // The kernel refused the first datagram itself (e.g. an ICMP error latched from an earlier send); skip it
+            stats_.dropped++;
+            done++;
+            continue;
+        }
+
+        done += *sent;
+        sentNow += *sent;
+        stats_.sent += *sent;
+        if (run >= MIN_SEGMENT_RUN) {
+            stats_.segmented += *sent;
+        }
+        if (*sent < attempted) {
+            stats_.deferred++; // socket buffer full
+            break;
+        }
+    }
+
+    consume(done);
+    return sentNow;
+}
+
+void SendQueue::clear() {
+    count_ = 0;
+    bytes_used_ = 0;
+}
+
+// Length of the sendSegmented()-able run starting at `first`: same peer, one segment size, optionally a shorter
+// last datagram. Payloads of consecutive entries are always adjacent in bytes_.
+size_t SendQueue::segmentRun(size_t first) const {
+    const Entry& head = entries_[first];
+    if (head.length == 0) {
+        return 1;
+    }
+
+    size_t end = first + 1;
+    while (end < count_ && entries_[end].length == head.length && entries_[end].addr == head.addr) {
+        end++;
+    }
+    if (end < count_ && entries_[end].length > 0 && entries_[end].length < head.length && entries_[end].addr == head.addr) {
+        end++;
+    }
+    return end - first;
+}
+
+// Drops the first `count` entries and slides the rest, payloads included, to the front
+void SendQueue::consume(size_t count) {
+    if (count == count_) {
+        clear();
+        return;
+    }
+    if (count == 0) {
+        return;
+    }
+
+    const size_t base = entries_[count].offset;
+    std::memmove(&bytes_[0], &bytes_[base], bytes_used_ - base);
+    for (size_t i = count; i < count_; ++i) {
+        entries_[i - count] = entries_[i];
+        entries_[i - count].offset -= base;
+    }
+    count_ -= count;
+    bytes_used_ -= base;
+}
+
+} // namespace pulse::net::udp
@@ -0,0 +1,183 @@
+#include "pulse/net/udp/session_table.h"
+#include <bit>
+
+namespace pulse::net::udp {
+
+// Endpoint::hash() mixes towards the high bits; fold them down, since the low bits pick the home bucket
+static uint32_t tagOf(const Endpoint& peer) {
+    uint64_t h = peer.hash();
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    return static_cast<uint32_t>(h);
+}
+
+std::expected<SessionTable, ErrorCode> SessionTable::Create(size_t capacity, uint64_t idleTimeoutNs) {
+    if (capacity == 0 || capacity > (size_t{1} << 30)) {
+        return std::unexpected(ErrorCode::InvalidArgument);
+    }
+    // At least twice as many buckets as sessions keeps the load factor at or under one half
+    return SessionTable(capacity, std::bit_ceil(capacity * 2), idleTimeoutNs);
+}
+
+SessionTable::SessionTable(size_t capacity, size_t bucketCount, uint64_t idleTimeoutNs)
+    : buckets_(std::make_unique_for_overwrite<Bucket[]>(bucketCount)),
+      slots_(std::make_unique_for_overwrite<Slot[]>(capacity)),
+      capacity_(capacity),
+      bucket_mask_(static_cast<uint32_t>(bucketCount - 1)),
+      idle_timeout_ns_(idleTimeoutNs) {
+    for (size_t i = 0; i < bucketCount; ++i) {
+        buckets_[i] = Bucket{.tag = 0, .slot = kNone};
+    }
+    // Thread every slot onto the free list, lowest index first
+    for (size_t i = 0; i < capacity; ++i) {
+        slots_[i] = Slot{
+            .peer = Endpoint{},
+            .generation = 0,
+            .prev = kNone,
+            .next = (i + 1 < capacity) ? static_cast<uint32_t>(i + 1) : kNone,
+            .last_seen_ns = 0,
+            .live = false
+        };
+    }
+    free_ = 0;
+}
+
+std::expected<SessionLookup, ErrorCode> SessionTable::touch(const Endpoint& peer, uint64_t nowNs) {
+    const auto tag = tagOf(peer);
+    const uint32_t bucket = findBucket(peer, tag);
+    if (buckets_[bucket].slot != kNone) {
+        const uint32_t slot = buckets_[bucket].slot;
+        slots_[slot].last_seen_ns = nowNs;
+        if (slot != tail_) {
+            unlink(slot);
+            pushBack(slot);
+        }
+        return SessionLookup{.handle = {slot, slots_[slot].generation}, .created = false};
+    }
+
+    if (free_ == kNone) {
+        return std::unexpected(ErrorCode::PoolExhausted);
+    }
+
+    // findBucket() stopped on the empty bucket that ends the probe run; the new entry goes there
+    const uint32_t slot = free_;
+    free_ = slots_[slot].next;
+    slots_[slot].peer = peer;
+    slots_[slot].last_seen_ns = nowNs;
+    slots_[slot].live = true;
+    pushBack(slot);
+    buckets_[bucket] = Bucket{.tag = tag, .slot = slot};
+    size_++;
+    return SessionLookup{.handle = {slot, slots_[slot].generation}, .created = true};
+}
+
+std::optional<SessionHandle> SessionTable::find(const Endpoint& peer) const {
+    const uint32_t bucket = findBucket(peer, tagOf(peer));
+    const uint32_t slot = buckets_[bucket].slot;
+    if (slot == kNone) {
+        return std::nullopt;
+    }
+    return SessionHandle{slot, slots_[slot].generation};
+}
+
+bool SessionTable::contains(SessionHandle handle) const {
+    return handle.index < capacity_ && slots_[handle.index].live && slots_[handle.index].generation == handle.generation;
+}
+
+const Endpoint* SessionTable::peer(SessionHandle handle) const {
+    return contains(handle) ? &slots_[handle.index].peer : nullptr;
+}
+
+bool SessionTable::remove(SessionHandle handle) {
+    if (!contains(handle)) {
+        return false;
+    }
+    release(handle.index);
+    return true;
+}
+
+size_t SessionTable::evictIdle(uint64_t nowNs, std::span<SessionHandle> evicted) {
+    if (idle_timeout_ns_ == 0) {
+        return 0;
+    }
+
+    // The recency list is ordered by last touch, so the idle sessions are exactly a prefix of it
+    size_t count = 0;
+    while (count < evicted.size() && head_ != kNone) {
+        const uint32_t slot = head_;
+        if (nowNs < slots_[slot].last_seen_ns || nowNs - slots_[slot].last_seen_ns < idle_timeout_ns_) {
+            break;
+        }
+        evicted[count++] = SessionHandle{slot, slots_[slot].generation};
+        release(slot);
+    }
+    return count;
+}
+
+// Bucket holding `peer`, or the empty bucket where its probe run ends
+uint32_t SessionTable::findBucket(const Endpoint& peer, uint32_t tag) const {
+    uint32_t bucket = tag & bucket_mask_;
+    while (true) {
+        const Bucket& b = buckets_[bucket];
+        if (b.slot == kNone || (b.tag == tag && slots_[b.slot].peer == peer)) {
+            return bucket;
+        }
+        bucket = (bucket + 1) & bucket_mask_;
+    }
+}
+
+// Backward-shift deletion: pull later members of the probe run into the hole so lookups never need tombstones
+void SessionTable::eraseBucket(uint32_t hole) {
+    uint32_t next = (hole + 1) & bucket_mask_;
+    while (buckets_[next].slot != kNone) {
+        const uint32_t home = buckets_[next].tag & bucket_mask_;
+        // Move the entry back unless its home lies cyclically in (hole, next], where it must stay reachable
+        const bool stays = (hole <= next) ? (hole < home && home <= next) : (hole < home || home <= next);
+        if (!stays) {
+            buckets_[hole] = buckets_[next];
+            hole = next;
+        }
+        next = (next + 1) & bucket_mask_;
+    }
+    buckets_[hole] = Bucket{.tag = 0, .slot = kNone};
+}
+
+void SessionTable::unlink(uint32_t slot) {
+    Slot& s = slots_[slot];
+    if (s.prev != kNone) {
+        slots_[s.prev].next = s.next;
+    } else {
+        head_ = s.next;
+    }
+    if (s.next != kNone) {
+        slots_[s.next].prev = s.prev;
+    } else {
+        tail_ = s.prev;
+    }
+    s.prev = kNone;
+    s.next = kNone;
+}
+
+void SessionTable::pushBack(uint32_t slot) {
+    slots_[slot].prev = tail_;
+    slots_[slot].next = kNone;
+    if (tail_ != kNone) {
+        slots_[tail_].next = slot;
+    } else {
+        head_ = slot;
+    }
+    tail_ = slot;
+}
+
+void SessionTable::release(uint32_t slot) {
+    eraseBucket(findBucket(slots_[slot].peer, tagOf(slots_[slot].peer)));
+    unlink(slot);
+    slots_[slot].live = false;
+    slots_[slot].generation++;
+    slots_[slot].next = free_;
+    free_ = slot;
+    size_--;
+}
+
+} // namespace pulse::net::udp
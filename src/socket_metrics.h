@@ -0,0 +1,153 @@
+#pragma once
+
+#include "pulse/net/udp/metrics.h"
+#include "pulse/net/udp/error_code.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <expected>
+
+namespace pulse::net::udp {
+
+#if defined(PULSENET_UDP_METRICS)
+
+// Lock-free counters behind Socket::metrics(). Relaxed atomics only: a snapshot may tear across fields,
+// which is fine for periodic scraping, and the owning thread never contends with a reader.
+class MetricsRecorder {
+public:
+    // Timestamp to hand back to the matching record call
+    static uint64_t start() {
+        return nowNs();
+    }
+
+    void sent(uint64_t startNs, size_t packets, size_t bytes) {
+        send_calls_.fetch_add(1, std::memory_order_relaxed);
+        packets_sent_.fetch_add(packets, std::memory_order_relaxed);
+        bytes_sent_.fetch_add(bytes, std::memory_order_relaxed);
+        send_latency_.record(nowNs() - startNs);
+    }
+
+    void received(uint64_t startNs, size_t packets, size_t bytes) {
+        recv_calls_.fetch_add(1, std::memory_order_relaxed);
+        packets_received_.fetch_add(packets, std::memory_order_relaxed);
+        bytes_received_.fetch_add(bytes, std::memory_order_relaxed);
+        recv_latency_.record(nowNs() - startNs);
+    }
+
+    // Datagrams the kernel delivered asynchronously (io_uring completions): counted, but no syscall to time
+    void receivedAsync(size_t packets, size_t bytes) {
+        recv_calls_.fetch_add(1, std::memory_order_relaxed);
+        packets_received_.fetch_add(packets, std::memory_order_relaxed);
+        bytes_received_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    // Records a failed send and passes the error through, so call sites stay `return metrics_.sendError(...);`
+    std::unexpected<ErrorCode> sendError(std::unexpected<ErrorCode> error) {
+        send_calls_.fetch_add(1, std::memory_order_relaxed);
+        send_errors_[SocketMetrics::ErrorSlot(error.error())].fetch_add(1, std::memory_order_relaxed);
+        return error;
+    }
+
+    std::unexpected<ErrorCode> recvError(std::unexpected<ErrorCode> error) {
+        recv_calls_.fetch_add(1, std::memory_order_relaxed);
+        recv_errors_[SocketMetrics::ErrorSlot(error.error())].fetch_add(1, std::memory_order_relaxed);
+        return error;
+    }
+
+    void truncated(size_t count = 1) {
+        truncated_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    void dropped(size_t count = 1) {
+        dropped_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    std::expected<SocketMetrics, ErrorCode> snapshot() const {
+        SocketMetrics m{};
+        m.packets_sent = packets_sent_.load(std::memory_order_relaxed);
+        m.bytes_sent = bytes_sent_.load(std::memory_order_relaxed);
+        m.packets_received = packets_received_.load(std::memory_order_relaxed);
+        m.bytes_received = bytes_received_.load(std::memory_order_relaxed);
+        m.send_calls = send_calls_.load(std::memory_order_relaxed);
+        m.recv_calls = recv_calls_.load(std::memory_order_relaxed);
+        m.truncated = truncated_.load(std::memory_order_relaxed);
+        m.dropped = dropped_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < kErrorCounterSlots; ++i) {
+            m.send_errors[i] = send_errors_[i].load(std::memory_order_relaxed);
+            m.recv_errors[i] = recv_errors_[i].load(std::memory_order_relaxed);
+        }
+        send_latency_.copyTo(m.send_latency);
+        recv_latency_.copyTo(m.recv_latency);
+        return m;
+    }
+
+private:
+    class AtomicHistogram {
+    public:
+        void record(uint64_t ns) {
+            counts_[LatencyBucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
+            samples_.fetch_add(1, std::memory_order_relaxed);
+            sum_ns_.fetch_add(ns, std::memory_order_relaxed);
+            uint64_t max = max_ns_.load(std::memory_order_relaxed);
+            while (ns > max && !max_ns_.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+            }
+        }
+
+        void copyTo(LatencyHistogram& out) const {
+            for (size_t i = 0; i < kLatencyBuckets; ++i) {
+                out.counts[i] = counts_[i].load(std::memory_order_relaxed);
+            }
+            out.samples = samples_.load(std::memory_order_relaxed);
+            out.sum_ns = sum_ns_.load(std::memory_order_relaxed);
+            out.max_ns = max_ns_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<uint64_t> counts_[kLatencyBuckets] = {};
+        std::atomic<uint64_t> samples_{0};
+        std::atomic<uint64_t> sum_ns_{0};
+        std::atomic<uint64_t> max_ns_{0};
+    };
+
+    static uint64_t nowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    std::atomic<uint64_t> packets_sent_{0};
+    std::atomic<uint64_t> bytes_sent_{0};
+    std::atomic<uint64_t> packets_received_{0};
+    std::atomic<uint64_t> bytes_received_{0};
+    std::atomic<uint64_t> send_calls_{0};
+    std::atomic<uint64_t> recv_calls_{0};
+    std::atomic<uint64_t> truncated_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> send_errors_[kErrorCounterSlots] = {};
+    std::atomic<uint64_t> recv_errors_[kErrorCounterSlots] = {};
+    AtomicHistogram send_latency_;
+    AtomicHistogram recv_latency_;
+};
+
+#else
+
+// Compiled-out recorder: every call is an empty inline the optimiser removes
+class MetricsRecorder {
+public:
+    static uint64_t start() { return 0; }
+    void sent(uint64_t, size_t, size_t) {}
+    void received(uint64_t, size_t, size_t) {}
+    void receivedAsync(size_t, size_t) {}
+    std::unexpected<ErrorCode> sendError(std::unexpected<ErrorCode> error) { return error; }
+    std::unexpected<ErrorCode> recvError(std::unexpected<ErrorCode> error) { return error; }
+    void truncated(size_t = 1) {}
+    void dropped(size_t = 1) {}
+
+    std::expected<SocketMetrics, ErrorCode> snapshot() const {
+        return std::unexpected(ErrorCode::NotSupported);
+    }
+};
+
+#endif
+
+} // namespace pulse::net::udp
@@ -1,4 +1,8 @@
 #include "pulse/net/udp/udp.h"
+#include "pulse/net/udp/listen_group.h"
+#include "pulse/net/udp/peer_session.h"
+#include "udp_uring.h"
+#include "socket_metrics.h"
 #include <unistd.h>
 #include <fcntl.h>
 #include <cstring>
@@ -7,14 +11,51 @@
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <errno.h>
+#include <algorithm>
+#include <climits>
+#include <iterator>
+#include <thread>
+#include <pthread.h>
+
+#if defined(__linux__)
+#include <netinet/udp.h>
+#include <linux/filter.h>
+#include <sched.h>
+#endif
 
 namespace pulse::net::udp {
 
 constexpr size_t PACKET_BUFFER_SIZE = 2048;
 
-class SocketUnix : public Socket {
+// Control space for an SCM_TIMESTAMPNS plus an SO_RXQ_OVFL message
+constexpr size_t RX_CONTROL_SIZE = 64;
+
+// With MSG_TRUNC Linux returns a datagram's full length even when it was cut to fit the buffer
+#if defined(__linux__)
+constexpr int RECV_FLAGS = MSG_TRUNC;
+#else
+constexpr int RECV_FLAGS = 0;
+#endif
+
+// Grow-only thread-local receive space for sockets whose max_datagram_size exceeds PACKET_BUFFER_SIZE,
+// so the common small-datagram path keeps its fixed buffers and never allocates
+struct JumboBuffer {
+    std::unique_ptr<uint8_t[]> storage;
+    size_t capacity = 0;
+
+    uint8_t* reserve(size_t bytes) {
+        if (capacity < bytes) {
+            storage = std::make_unique_for_overwrite<uint8_t[]>(bytes);
+            capacity = bytes;
+        }
+        return storage.get();
+    }
+};
+
+class SocketUnix final : public Socket {
 public:
-    SocketUnix(int sockfd) : sockfd_(sockfd) {}
+    SocketUnix(int sockfd, bool rxControl = false, size_t maxDatagram = kDefaultMaxDatagramSize)
+        : sockfd_(sockfd), rx_control_(rxControl), max_datagram_(maxDatagram) {}
     ~SocketUnix() override {
         close();
     }
@@ -33,7 +74,20 @@ public:
         }
     }
 
+    inline std::unexpected<ErrorCode> mapRecvErrno(int err) {
+        switch (err) {
+            case EWOULDBLOCK:
+                return std::unexpected(ErrorCode::WouldBlock);
+            case EBADF:
+            case ENOTSOCK:
+                return std::unexpected(ErrorCode::InvalidSocket);
+            default:
+                return std::unexpected(ErrorCode::RecvFailed);
+        }
+    }
+
     std::expected<void, ErrorCode> sendTo(const Addr& addr, const uint8_t* data, size_t length) override {
+        const uint64_t start = metrics_.start();
         ssize_t sent = sendto(
             sockfd_,
             data,
@@ -44,122 +98,807 @@ public:
         );
 
         if (sent < 0) {
-            return mapSendErrno(errno);
+            return metrics_.sendError(mapSendErrno(errno));
         }
     
         if (sent != static_cast<ssize_t>(length)) {
-            return std::unexpected(ErrorCode::PartialSend);
+            return metrics_.sendError(std::unexpected(ErrorCode::PartialSend));
         }
     
+        metrics_.sent(start, 1, length);
+        return {}; // success
+    }
+
+    std::expected<void, ErrorCode> sendTo(const Endpoint& addr, const uint8_t* data, size_t length) override {
+        sockaddr_storage dst;
+        size_t dstlen = addr.toSockaddr(&dst);
+        if (dstlen == 0) {
+            return std::unexpected(ErrorCode::InvalidAddress);
+        }
+
+        const uint64_t start = metrics_.start();
+        ssize_t sent = ::sendto(
+            sockfd_,
+            data,
+            length,
+            0,
+            reinterpret_cast<const sockaddr*>(&dst),
+            static_cast<socklen_t>(dstlen)
+        );
+
+        if (sent < 0) {
+            return metrics_.sendError(mapSendErrno(errno));
+        }
+
+        if (sent != static_cast<ssize_t>(length)) {
+            return metrics_.sendError(std::unexpected(ErrorCode::PartialSend));
+        }
+
+        metrics_.sent(start, 1, length);
         return {}; // success
     }
 
     std::expected<void, ErrorCode> send(const uint8_t* data, size_t length) override {
+        const uint64_t start = metrics_.start();
         ssize_t sent = ::send(sockfd_, data, length, 0);
 
         if (sent < 0) {
-            return mapSendErrno(errno);
+            return metrics_.sendError(mapSendErrno(errno));
         }
     
         if (sent != static_cast<ssize_t>(length)) {
-            return std::unexpected(ErrorCode::PartialSend);
+            return metrics_.sendError(std::unexpected(ErrorCode::PartialSend));
         }
     
+        metrics_.sent(start, 1, length);
         return {}; // success
     }
 
+    std::expected<size_t, ErrorCode> sendBatch(std::span<const OutgoingPacket> packets) override {
+        size_t accepted = 0;
+
+        while (accepted < packets.size()) {
+            const size_t count = std::min(packets.size() - accepted, kMaxSendBatch);
+            const OutgoingPacket* chunk = packets.data() + accepted;
+
+#if defined(__linux__)
+            mmsghdr msgs[kMaxSendBatch];
+            iovec iovs[kMaxSendBatch];
+            sockaddr_storage dsts[kMaxSendBatch];
+            for (size_t i = 0; i < count; ++i) {
+                iovs[i].iov_base = const_cast<uint8_t*>(chunk[i].data);
+                iovs[i].iov_len = chunk[i].length;
+                msgs[i].msg_hdr = msghdr{};
+                if (chunk[i].addr.isSpecified()) {
+                    msgs[i].msg_hdr.msg_name = &dsts[i];
+                    msgs[i].msg_hdr.msg_namelen = static_cast<socklen_t>(chunk[i].addr.toSockaddr(&dsts[i]));
+                }
+                msgs[i].msg_hdr.msg_iov = &iovs[i];
+                msgs[i].msg_hdr.msg_iovlen = 1;
+                msgs[i].msg_len = 0;
+            }
+
+            const uint64_t start = metrics_.start();
+            int sent = ::sendmmsg(sockfd_, msgs, static_cast<unsigned int>(count), 0);
+            if (sent < 0) {
+                auto error = metrics_.sendError(mapSendErrno(errno));
+                if (accepted == 0) {
+                    return error;
+                }
+                break;
+            }
+
+            size_t sentBytes = 0;
+            for (int i = 0; i < sent; ++i) {
+                sentBytes += chunk[i].length;
+            }
+            metrics_.sent(start, static_cast<size_t>(sent), sentBytes);
+
+            accepted += static_cast<size_t>(sent);
+            if (static_cast<size_t>(sent) < count) {
+                break; // socket buffer full; the caller retries the remainder
+            }
+#else
+            // No sendmmsg() here; fall back to one sendto() per datagram
+            size_t i = 0;
+            for (; i < count; ++i) {
+                const auto& packet = chunk[i];
+                sockaddr_storage dst;
+                size_t dstlen = packet.addr.toSockaddr(&dst);
+                const uint64_t start = metrics_.start();
+                ssize_t sent = ::sendto(
+                    sockfd_,
+                    packet.data,
+                    packet.length,
+                    0,
+                    dstlen ? reinterpret_cast<const sockaddr*>(&dst) : nullptr,
+                    static_cast<socklen_t>(dstlen)
+                );
+
+                if (sent < 0) {
+                    break;
+                }
+                metrics_.sent(start, 1, packet.length);
+            }
+
+            if (i < count) {
+                auto error = metrics_.sendError(mapSendErrno(errno));
+                if (i == 0 && accepted == 0) {
+                    return error;
+                }
+            }
+
+            accepted += i;
+            if (i < count) {
+                break;
+            }
+#endif
+        }
+
+        return accepted;
+    }
+
+    std::expected<size_t, ErrorCode> sendSegmented(const Endpoint& addr, const uint8_t* data, size_t length, size_t segmentSize) override {
+        if (segmentSize == 0) {
+            return std::unexpected(ErrorCode::InvalidArgument);
+        }
+
+        size_t accepted = 0;
+        size_t offset = 0;
+
+#if defined(__linux__)
+        sockaddr_storage dst;
+        size_t dstlen = addr.toSockaddr(&dst);
+        const size_t segmentsPerCall = std::min(kMaxGsoSegments, std::max<size_t>(1, kMaxGsoBytes / segmentSize));
+
+        while (gso_supported_ && offset < length) {
+            const size_t chunkBytes = std::min(length - offset, segmentsPerCall * segmentSize);
+            const size_t chunkSegments = (chunkBytes + segmentSize - 1) / segmentSize;
+
+            iovec iov{const_cast<uint8_t*>(data + offset), chunkBytes};
+            alignas(cmsghdr) char control[CMSG_SPACE(sizeof(uint16_t))] = {};
+            msghdr msg{};
+            msg.msg_name = dstlen ? &dst : nullptr;
+            msg.msg_namelen = static_cast<socklen_t>(dstlen);
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+
+            // A single segment needs no offload; keep it a plain datagram
+            if (chunkSegments > 1) {
+                msg.msg_control = control;
+                msg.msg_controllen = sizeof(control);
+                cmsghdr* cm = CMSG_FIRSTHDR(&msg);
+                cm->cmsg_level = IPPROTO_UDP;
+                cm->cmsg_type = UDP_SEGMENT;
+                cm->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+                const uint16_t gsoSize = static_cast<uint16_t>(segmentSize);
+                std::memcpy(CMSG_DATA(cm), &gsoSize, sizeof(gsoSize));
+            }
+
+            const uint64_t start = metrics_.start();
+            ssize_t sent = ::sendmsg(sockfd_, &msg, 0);
+            if (sent < 0) {
+                const int err = errno;
+                if (chunkSegments > 1 && (err == EIO || err == ENOPROTOOPT || err == EOPNOTSUPP || err == EINVAL)) {
+                    // No usable GSO for this socket/route; EINVAL may just mean this segment size, so don't latch it
+                    if (err != EINVAL) {
+                        gso_supported_ = false;
+                    }
+                    break;
+                }
+                auto error = metrics_.sendError(mapSendErrno(err));
+                if (accepted == 0) {
+                    return error;
+                }
+                return accepted;
+            }
+
+            metrics_.sent(start, chunkSegments, chunkBytes);
+            offset += chunkBytes;
+            accepted += chunkSegments;
+        }
+#endif
+
+        // Fallback: one datagram per segment through sendBatch()
+        while (offset < length) {
+            OutgoingPacket packets[kMaxSendBatch];
+            size_t count = 0;
+            for (size_t cursor = offset; count < kMaxSendBatch && cursor < length; ++count) {
+                const size_t segmentBytes = std::min(segmentSize, length - cursor);
+                packets[count] = OutgoingPacket{.addr = addr, .data = data + cursor, .length = segmentBytes};
+                cursor += segmentBytes;
+            }
+
+            auto sent = sendBatch(std::span<const OutgoingPacket>(packets, count));
+            if (!sent) {
+                if (accepted == 0) {
+                    return std::unexpected(sent.error());
+                }
+                break;
+            }
+
+            for (size_t i = 0; i < *sent; ++i) {
+                offset += packets[i].length;
+            }
+            accepted += *sent;
+            if (*sent < count) {
+                break;
+            }
+        }
+
+        return accepted;
+    }
+
     std::expected<ReceivedPacket, ErrorCode> recvFrom() override {
         static thread_local uint8_t buf[PACKET_BUFFER_SIZE];
+        if (max_datagram_ <= PACKET_BUFFER_SIZE) {
+            return receiveInto(buf, max_datagram_);
+        }
+        static thread_local JumboBuffer jumbo;
+        return receiveInto(jumbo.reserve(max_datagram_), max_datagram_);
+    }
+
+    std::expected<ReceivedPacket, ErrorCode> recvFrom(std::span<uint8_t> buffer) override {
+        return receiveInto(buffer.data(), buffer.size());
+    }
+
+    std::expected<void, ErrorCode> recvInto(PacketBuffer& packet) override {
+        auto storage = packet.storage();
+        auto received = receiveInto(storage.data(), storage.size());
+        if (!received) {
+            return std::unexpected(received.error());
+        }
+
+        packet.setAddr(received->addr);
+        packet.setTruncated(received->truncated);
+        return packet.resize(received->length);
+    }
+
+    std::expected<size_t, ErrorCode> recvBatch(std::span<ReceivedPacket> packets) override {
+        static thread_local uint8_t bufs[kMaxRecvBatch][PACKET_BUFFER_SIZE];
+        const size_t count = std::min(packets.size(), kMaxRecvBatch);
+        if (count == 0) {
+            return 0;
+        }
+
+        // Slot i starts at base + i * stride
+        uint8_t* base = bufs[0];
+        size_t stride = PACKET_BUFFER_SIZE;
+        if (max_datagram_ > PACKET_BUFFER_SIZE) {
+            static thread_local JumboBuffer jumbo;
+            stride = max_datagram_;
+            base = jumbo.reserve(count * stride);
+        }
+
+        sockaddr_storage srcs[kMaxRecvBatch];
+        size_t lengths[kMaxRecvBatch]; // full datagram sizes, which exceed max_datagram_ when truncated
+        size_t received = 0;
+
+#if defined(__linux__)
+        // One recvmmsg() drains as many queued datagrams as there are slots
+        mmsghdr msgs[kMaxRecvBatch];
+        iovec iovs[kMaxRecvBatch];
+        alignas(cmsghdr) uint8_t controls[kMaxRecvBatch][RX_CONTROL_SIZE];
+        for (size_t i = 0; i < count; ++i) {
+            iovs[i].iov_base = base + i * stride;
+            iovs[i].iov_len = max_datagram_;
+            msgs[i].msg_hdr = msghdr{};
+            msgs[i].msg_hdr.msg_name = &srcs[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            if (rx_control_) {
+                msgs[i].msg_hdr.msg_control = controls[i];
+                msgs[i].msg_hdr.msg_controllen = RX_CONTROL_SIZE;
+            }
+            msgs[i].msg_len = 0;
+        }
+
+        const uint64_t start = metrics_.start();
+        int n = ::recvmmsg(sockfd_, msgs, static_cast<unsigned int>(count), RECV_FLAGS, nullptr);
+        if (n < 0) {
+            return metrics_.recvError(mapRecvErrno(errno));
+        }
+
+        received = static_cast<size_t>(n);
+        size_t receivedBytes = 0;
+        for (size_t i = 0; i < received; ++i) {
+            lengths[i] = msgs[i].msg_len;
+            receivedBytes += std::min(lengths[i], max_datagram_);
+            if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+                metrics_.truncated();
+            }
+        }
+        metrics_.received(start, received, receivedBytes);
+#else
+        // No recvmmsg() here; drain with one recvfrom() per datagram instead
+        for (; received < count; ++received) {
+            socklen_t srclen = sizeof(sockaddr_storage);
+            const uint64_t start = metrics_.start();
+            ssize_t n = ::recvfrom(
+                sockfd_,
+                base + received * stride,
+                max_datagram_,
+                RECV_FLAGS,
+                reinterpret_cast<sockaddr*>(&srcs[received]),
+                &srclen
+            );
+
+            if (n < 0) {
+                auto error = metrics_.recvError(mapRecvErrno(errno));
+                if (received == 0) {
+                    return error;
+                }
+                break;
+            }
+
+            lengths[received] = static_cast<size_t>(n);
+            metrics_.received(start, 1, std::min(lengths[received], max_datagram_)); // bytes delivered, as on Linux
+        }
+#endif
+
+        // Datagrams from undecodable sources are dropped rather than failing the whole batch
+        size_t filled = 0;
+        for (size_t i = 0; i < received; ++i) {
+            auto addrResult = decodeAddr(reinterpret_cast<const sockaddr*>(&srcs[i]));
+            if (!addrResult || addrResult->port() == 0) {
+                metrics_.dropped();
+                continue;
+            }
+
+            packets[filled] = ReceivedPacket{
+                .data = base + i * stride,
+                .length = std::min(lengths[i], max_datagram_),
+                .addr = *addrResult,
+                .truncated = lengths[i] > max_datagram_,
+                .datagram_length = lengths[i]
+            };
+#if defined(__linux__)
+            if (rx_control_) {
+                parseRxControl(msgs[i].msg_hdr, packets[filled]);
+            }
+#endif
+            filled++;
+        }
+
+        if (filled == 0) {
+            return std::unexpected(ErrorCode::WouldBlock); // everything pending was dropped
+        }
+        return filled;
+    }
+
+    std::expected<void, ErrorCode> enableGro() override {
+#if defined(__linux__)
+        int on = 1;
+        if (::setsockopt(sockfd_, IPPROTO_UDP, UDP_GRO, &on, sizeof(on)) < 0) {
+            return std::unexpected(errno == ENOPROTOOPT ? ErrorCode::NotSupported : ErrorCode::SocketConfigFailed);
+        }
+        return {};
+#else
+        return std::unexpected(ErrorCode::NotSupported);
+#endif
+    }
+
+    std::expected<CoalescedPacket, ErrorCode> recvCoalesced() override {
+        // GRO payloads overflow the shared thread-local buffer, so each socket owns one full-size buffer
+        if (!coalesced_buf_) {
+            coalesced_buf_ = std::make_unique_for_overwrite<uint8_t[]>(kMaxCoalescedBytes);
+        }
+
+        sockaddr_storage src{};
+        iovec iov{coalesced_buf_.get(), kMaxCoalescedBytes};
+        msghdr msg{};
+        msg.msg_name = &src;
+        msg.msg_namelen = sizeof(src);
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+#if defined(__linux__)
+        // Room for the GRO segment size next to the timestamp / drop counter messages the socket may also have on;
+        // a truncated control block could otherwise lose the segment size
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int)) + RX_CONTROL_SIZE];
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+#endif
+
+        const uint64_t start = metrics_.start();
+        ssize_t received = ::recvmsg(sockfd_, &msg, 0);
+        if (received < 0) {
+            return metrics_.recvError(mapRecvErrno(errno));
+        }
+
+        if (received == 0) {
+            return std::unexpected(ErrorCode::Closed);
+        }
+
+        auto addrResult = decodeAddr(reinterpret_cast<const sockaddr*>(&src));
+        if (!addrResult) {
+            return std::unexpected(addrResult.error());
+        }
+
+        if (addrResult->port() == 0) {
+            return std::unexpected(ErrorCode::InvalidAddress);
+        }
+
+        metrics_.received(start, 1, static_cast<size_t>(received));
+        size_t segmentSize = static_cast<size_t>(received);
+#if defined(__linux__)
+        for (cmsghdr* cm = CMSG_FIRSTHDR(&msg); cm != nullptr; cm = CMSG_NXTHDR(&msg, cm)) {
+            if (cm->cmsg_level == IPPROTO_UDP && cm->cmsg_type == UDP_GRO) {
+                int gsoSize = 0;
+                std::memcpy(&gsoSize, CMSG_DATA(cm), sizeof(gsoSize));
+                if (gsoSize > 0) {
+                    segmentSize = static_cast<size_t>(gsoSize);
+                }
+            }
+        }
+#endif
+
+        return CoalescedPacket{
+            .data = coalesced_buf_.get(),
+            .length = static_cast<size_t>(received),
+            .segmentSize = segmentSize,
+            .addr = *addrResult
+        };
+    }
+
+    std::expected<SocketMetrics, ErrorCode> metrics() const override {
+        return metrics_.snapshot();
+    }
+
+    std::expected<SocketConfig, ErrorCode> effectiveConfig() const override {
+        if (sockfd_ == -1) {
+            return std::unexpected(ErrorCode::InvalidSocket);
+        }
+
+        sockaddr_storage local{};
+        socklen_t localLen = sizeof(local);
+        if (::getsockname(sockfd_, reinterpret_cast<sockaddr*>(&local), &localLen) < 0) {
+            return std::unexpected(ErrorCode::SocketConfigFailed);
+        }
+        const bool v6 = local.ss_family == AF_INET6;
+
+        SocketConfig config;
+        config.max_datagram_size = max_datagram_;
+        int value = 0;
+        if (getIntOption(SOL_SOCKET, SO_RCVBUF, value)) {
+            config.recv_buffer_size = static_cast<size_t>(value);
+        }
+        if (getIntOption(SOL_SOCKET, SO_SNDBUF, value)) {
+            config.send_buffer_size = static_cast<size_t>(value);
+        }
+        if (v6 ? getIntOption(IPPROTO_IPV6, IPV6_TCLASS, value) : getIntOption(IPPROTO_IP, IP_TOS, value)) {
+            config.dscp = (value >> 2) & 0x3F;
+        }
+#if defined(SO_REUSEPORT)
+        if (getIntOption(SOL_SOCKET, SO_REUSEPORT, value)) {
+            config.reuse_port = value != 0;
+        }
+#endif
+#if defined(__linux__)
+        if (getIntOption(SOL_SOCKET, SO_BUSY_POLL, value)) {
+            config.busy_poll_us = static_cast<uint32_t>(value);
+        }
+        if (getIntOption(SOL_SOCKET, SO_PRIORITY, value)) {
+            config.priority = value;
+        }
+        if (getIntOption(SOL_SOCKET, SO_INCOMING_CPU, value)) {
+            config.incoming_cpu = value;
+        }
+        if (getIntOption(SOL_SOCKET, SO_TIMESTAMPNS, value)) {
+            config.rx_timestamps = value != 0;
+        }
+        if (getIntOption(SOL_SOCKET, SO_RXQ_OVFL, value)) {
+            config.rx_drop_counter = value != 0;
+        }
+        if (v6 ? getIntOption(IPPROTO_IPV6, IPV6_MTU_DISCOVER, value) : getIntOption(IPPROTO_IP, IP_MTU_DISCOVER, value)) {
+            if (value == (v6 ? IPV6_PMTUDISC_DONT : IP_PMTUDISC_DONT)) {
+                config.mtu_discovery = MtuDiscovery::Dont;
+            } else if (value == (v6 ? IPV6_PMTUDISC_DO : IP_PMTUDISC_DO)) {
+                config.mtu_discovery = MtuDiscovery::Do;
+            } else if (value == (v6 ? IPV6_PMTUDISC_PROBE : IP_PMTUDISC_PROBE)) {
+                config.mtu_discovery = MtuDiscovery::Probe;
+            }
+        }
+#endif
+        return config;
+    }
+
+    std::expected<Endpoint, ErrorCode> localEndpoint() const override {
+        if (sockfd_ == -1) {
+            return std::unexpected(ErrorCode::InvalidSocket);
+        }
+
+        sockaddr_storage local{};
+        socklen_t localLen = sizeof(local);
+        if (::getsockname(sockfd_, reinterpret_cast<sockaddr*>(&local), &localLen) < 0) {
+            return std::unexpected(ErrorCode::InvalidSocket);
+        }
+        return decodeAddr(reinterpret_cast<const sockaddr*>(&local));
+    }
+
+    std::expected<int, ErrorCode> getHandle() const override {
+        if (sockfd_ == -1) {
+            return std::unexpected(ErrorCode::InvalidSocket);
+        }
+        return sockfd_;
+    }    
+
+    void close() override {
+        if (sockfd_ != -1) {
+            ::close(sockfd_);
+            sockfd_ = -1;
+        }
+    }
+
+    // Throws away every queued datagram, counting each in SocketMetrics::dropped; returns how many there were
+    size_t discardQueued() {
+        uint8_t unused[1];
+        size_t discarded = 0;
+        while (::recv(sockfd_, unused, sizeof(unused), 0) >= 0) {
+            metrics_.dropped();
+            discarded++;
+        }
+        return discarded;
+    }
+
+private:
+    std::expected<ReceivedPacket, ErrorCode> receiveInto(uint8_t* buf, size_t capacity) {
+#if defined(__linux__)
+        if (rx_control_) {
+            return receiveWithControl(buf, capacity);
+        }
+#endif
         sockaddr_storage src{};
         socklen_t srclen = sizeof(src);
     
+        const uint64_t start = metrics_.start();
         ssize_t received = ::recvfrom(
             sockfd_,
             buf,
-            sizeof(buf),
-            0,
+            capacity,
+            RECV_FLAGS,
             reinterpret_cast<sockaddr*>(&src),
             &srclen
         );
     
         if (received < 0) {
-            switch (errno) {
-                case EWOULDBLOCK:
-                    return std::unexpected(ErrorCode::WouldBlock);
-    
-                case EBADF:
-                case ENOTSOCK:
-                    return std::unexpected(ErrorCode::InvalidSocket);
-    
-                default:
-                    return std::unexpected(ErrorCode::RecvFailed);
-            }
+            return metrics_.recvError(mapRecvErrno(errno));
         }
     
         if (received == 0) {
             return std::unexpected(ErrorCode::Closed); // rare, but possible
         }
     
+        const auto datagramLength = static_cast<size_t>(received);
+        const size_t length = std::min(datagramLength, capacity);
+        metrics_.received(start, 1, length);
+        if (datagramLength > capacity) {
+            metrics_.truncated();
+        }
+
         auto addrResult = decodeAddr(reinterpret_cast<sockaddr*>(&src));
         if (!addrResult) {
+            metrics_.dropped();
             return std::unexpected(addrResult.error());
         }
 
         const auto& addr = *addrResult;
-        if (addr.port == 0) {
+        if (addr.port() == 0) {
+            metrics_.dropped();
             return std::unexpected(ErrorCode::InvalidAddress);
         }
 
         return ReceivedPacket{
             .data = reinterpret_cast<const uint8_t*>(buf),
-            .length = static_cast<size_t>(received),
-            .addr = addr
+            .length = length,
+            .addr = addr,
+            .truncated = datagramLength > capacity,
+            .datagram_length = datagramLength
         };
-    }    
+    }
 
-    std::expected<int, ErrorCode> getHandle() const override {
-        if (sockfd_ == -1) {
-            return std::unexpected(ErrorCode::InvalidSocket);
+#if defined(__linux__)
+    // recvmsg() variant of receiveInto() that also collects the timestamp / drop counter control messages
+    std::expected<ReceivedPacket, ErrorCode> receiveWithControl(uint8_t* buf, size_t capacity) {
+        sockaddr_storage src{};
+        alignas(cmsghdr) uint8_t control[RX_CONTROL_SIZE];
+        iovec iov{buf, capacity};
+        msghdr msg{};
+        msg.msg_name = &src;
+        msg.msg_namelen = sizeof(src);
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        const uint64_t start = metrics_.start();
+        ssize_t received = ::recvmsg(sockfd_, &msg, RECV_FLAGS);
+        if (received < 0) {
+            return metrics_.recvError(mapRecvErrno(errno));
         }
-        return sockfd_;
-    }    
 
-    void close() override {
-        if (sockfd_ != -1) {
-            ::close(sockfd_);
-            sockfd_ = -1;
+        if (received == 0) {
+            return std::unexpected(ErrorCode::Closed);
         }
+
+        const auto datagramLength = static_cast<size_t>(received);
+        const size_t length = std::min(datagramLength, capacity);
+        metrics_.received(start, 1, length);
+        if (msg.msg_flags & MSG_TRUNC) {
+            metrics_.truncated();
+        }
+
+        auto addrResult = decodeAddr(reinterpret_cast<sockaddr*>(&src));
+        if (!addrResult || addrResult->port() == 0) {
+            metrics_.dropped();
+            return std::unexpected(addrResult ? ErrorCode::InvalidAddress : addrResult.error());
+        }
+
+        ReceivedPacket packet{
+            .data = buf,
+            .length = length,
+            .addr = *addrResult,
+            .truncated = datagramLength > capacity,
+            .datagram_length = datagramLength
+        };
+        parseRxControl(msg, packet);
+        return packet;
     }
+#endif
 
-private:
     int sockfd_;
+    MetricsRecorder metrics_;
+    bool rx_control_; // SO_TIMESTAMPNS / SO_RXQ_OVFL are on, so receives must read control messages
+    size_t max_datagram_; // SocketConfig::max_datagram_size: receive size for recvFrom()/recvBatch()
+    std::unique_ptr<uint8_t[]> coalesced_buf_;
+#if defined(__linux__)
+    bool gso_supported_ = true; // cleared once the kernel refuses UDP_SEGMENT
+#endif
 
-    static std::expected<Addr, ErrorCode> decodeAddr(const sockaddr* addr) {
-        char ip[INET6_ADDRSTRLEN];
-        uint16_t port = 0;
-    
-        if (addr->sa_family == AF_INET) {
-            auto* a = reinterpret_cast<const sockaddr_in*>(addr);
-            if (!inet_ntop(AF_INET, &a->sin_addr, ip, sizeof(ip))) {
-                return std::unexpected(ErrorCode::InvalidAddress);
-            }
-            port = ntohs(a->sin_port);
-        } else if (addr->sa_family == AF_INET6) {
-            auto* a = reinterpret_cast<const sockaddr_in6*>(addr);
-            if (!inet_ntop(AF_INET6, &a->sin6_addr, ip, sizeof(ip))) {
-                return std::unexpected(ErrorCode::InvalidAddress);
-            }
-            port = ntohs(a->sin6_port);
-        } else {
+    bool getIntOption(int level, int opt, int& value) const {
+        socklen_t len = sizeof(value);
+        return ::getsockopt(sockfd_, level, opt, &value, &len) == 0;
+    }
+
+#if defined(__linux__)
+    static void parseRxControl(const msghdr& msg, ReceivedPacket& packet) {
+        for (const cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(const_cast<msghdr*>(&msg), const_cast<cmsghdr*>(cmsg))) {
+            if (cmsg->cmsg_level != SOL_SOCKET) {
+                continue;
+            }
+            if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+                timespec ts;
+                std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+                packet.rx_timestamp_ns = static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000 + static_cast<uint64_t>(ts.tv_nsec);
+            } else if (cmsg->cmsg_type == SO_RXQ_OVFL) {
+                std::memcpy(&packet.drops, CMSG_DATA(cmsg), sizeof(packet.drops));
+            }
+        }
+    }
+#endif
+
+    static std::expected<Endpoint, ErrorCode> decodeAddr(const sockaddr* addr) {
+        Endpoint ep = Endpoint::FromSockaddr(addr);
+        if (!ep.isSpecified()) {
             return std::unexpected(ErrorCode::UnsupportedAddressFamily);
         }
-    
-        return Addr{ip, port};
+        return ep;
     }
     
 };
 
-std::expected<std::unique_ptr<Socket>, ErrorCode> Listen(const Addr& bindAddr) {
+#if defined(__linux__)
+// Sets a buffer size with the *FORCE variant first, which ignores the rmem_max/wmem_max ceiling but needs CAP_NET_ADMIN
+static bool setBufferSize(int sockfd, int forceOpt, int opt, size_t size) {
+    const int value = static_cast<int>(std::min<size_t>(size, INT_MAX));
+    if (::setsockopt(sockfd, SOL_SOCKET, forceOpt, &value, sizeof(value)) == 0) {
+        return true;
+    }
+    return ::setsockopt(sockfd, SOL_SOCKET, opt, &value, sizeof(value)) == 0;
+}
+
+static int toPmtuMode(MtuDiscovery mode, bool v6) {
+    switch (mode) {
+    case MtuDiscovery::Dont: return v6 ? IPV6_PMTUDISC_DONT : IP_PMTUDISC_DONT;
+    case MtuDiscovery::Do: return v6 ? IPV6_PMTUDISC_DO : IP_PMTUDISC_DO;
+    case MtuDiscovery::Probe: return v6 ? IPV6_PMTUDISC_PROBE : IP_PMTUDISC_PROBE;
+    case MtuDiscovery::Default: break;
+    }
+    return -1;
+}
+#endif
+
+static std::expected<void, ErrorCode> setIntOption(int sockfd, int level, int opt, int value) {
+    if (::setsockopt(sockfd, level, opt, &value, sizeof(value)) < 0) {
+        return std::unexpected(ErrorCode::SocketConfigFailed);
+    }
+    return {};
+}
+
+// Applies every requested SocketConfig option to a fresh socket, before bind()/connect()
+static std::expected<void, ErrorCode> applySocketOptions(int sockfd, int family, const SocketConfig& config) {
+    if (config.dscp > 63 || config.max_datagram_size == 0 || config.max_datagram_size > kMaxDatagramSize) {
+        return std::unexpected(ErrorCode::InvalidArgument);
+    }
+
+    // Before SO_PRIORITY: on Linux, setting IP_TOS also rewrites the socket priority
+    if (config.dscp >= 0) {
+        const int tos = config.dscp << 2;
+        auto ok = (family == AF_INET6) ? setIntOption(sockfd, IPPROTO_IPV6, IPV6_TCLASS, tos) : setIntOption(sockfd, IPPROTO_IP, IP_TOS, tos);
+        if (!ok) {
+            return ok;
+        }
+    }
+
+#if defined(__linux__)
+    if (config.recv_buffer_size > 0 && !setBufferSize(sockfd, SO_RCVBUFFORCE, SO_RCVBUF, config.recv_buffer_size)) {
+        return std::unexpected(ErrorCode::SocketConfigFailed);
+    }
+    if (config.send_buffer_size > 0 && !setBufferSize(sockfd, SO_SNDBUFFORCE, SO_SNDBUF, config.send_buffer_size)) {
+        return std::unexpected(ErrorCode::SocketConfigFailed);
+    }
+    if (config.busy_poll_us > 0) {
+        if (auto ok = setIntOption(sockfd, SOL_SOCKET, SO_BUSY_POLL, static_cast<int>(std::min<uint32_t>(config.busy_poll_us, INT_MAX))); !ok) {
+            return ok;
+        }
+    }
+    if (config.priority >= 0) {
+        if (auto ok = setIntOption(sockfd, SOL_SOCKET, SO_PRIORITY, config.priority); !ok) {
+            return ok;
+        }
+    }
+    if (config.mtu_discovery != MtuDiscovery::Default) {
+        const bool v6 = family == AF_INET6;
+        if (auto ok = setIntOption(sockfd, v6 ? IPPROTO_IPV6 : IPPROTO_IP, v6 ? IPV6_MTU_DISCOVER : IP_MTU_DISCOVER, toPmtuMode(config.mtu_discovery, v6)); !ok) {
+            return ok;
+        }
+    }
+    if (config.incoming_cpu >= 0) {
+        if (auto ok = setIntOption(sockfd, SOL_SOCKET, SO_INCOMING_CPU, config.incoming_cpu); !ok) {
+            return ok;
+        }
+    }
+    if (config.rx_timestamps) {
+        if (auto ok = setIntOption(sockfd, SOL_SOCKET, SO_TIMESTAMPNS, 1); !ok) {
+            return ok;
+        }
+    }
+    if (config.rx_drop_counter) {
+        if (auto ok = setIntOption(sockfd, SOL_SOCKET, SO_RXQ_OVFL, 1); !ok) {
+            return ok;
+        }
+    }
+#else
+    if (config.busy_poll_us > 0 || config.priority >= 0 || config.mtu_discovery != MtuDiscovery::Default || config.incoming_cpu >= 0 ||
+        config.rx_timestamps || config.rx_drop_counter) {
+        return std::unexpected(ErrorCode::NotSupported);
+    }
+    if (config.recv_buffer_size > 0) {
+        if (auto ok = setIntOption(sockfd, SOL_SOCKET, SO_RCVBUF, static_cast<int>(std::min<size_t>(config.recv_buffer_size, INT_MAX))); !ok) {
+            return ok;
+        }
+    }
+    if (config.send_buffer_size > 0) {
+        if (auto ok = setIntOption(sockfd, SOL_SOCKET, SO_SNDBUF, static_cast<int>(std::min<size_t>(config.send_buffer_size, INT_MAX))); !ok) {
+            return ok;
+        }
+    }
+#endif
+
+    if (config.reuse_port) {
+#if defined(SO_REUSEPORT)
+        if (auto ok = setIntOption(sockfd, SOL_SOCKET, SO_REUSEPORT, 1); !ok) {
+            return ok;
+        }
+#else
+        return std::unexpected(ErrorCode::NotSupported);
+#endif
+    }
+
+    return {};
+}
+
+static std::expected<int, ErrorCode> openListenSocket(const Addr& bindAddr, const SocketConfig& config) {
     int family = AF_INET;
     const void* addrPtr = nullptr;
 
@@ -192,6 +931,11 @@ std::expected<std::unique_ptr<Socket>, ErrorCode> Listen(const Addr& bindAddr) {
         return std::unexpected(ErrorCode::SocketConfigFailed);
     }
 
+    if (auto applied = applySocketOptions(sockfd, family, config); !applied) {
+        ::close(sockfd);
+        return std::unexpected(applied.error());
+    }
+
     // Bind
     socklen_t socklen = (family == AF_INET) ? sizeof(sockaddr_in) : sizeof(sockaddr_in6);
     if (::bind(sockfd, reinterpret_cast<const sockaddr*>(addrPtr), socklen) < 0) {
@@ -199,10 +943,149 @@ std::expected<std::unique_ptr<Socket>, ErrorCode> Listen(const Addr& bindAddr) {
         return std::unexpected(ErrorCode::BindFailed);
     }
 
-    return std::make_unique<SocketUnix>(sockfd);
+    return sockfd;
+}
+
+// Hands a configured descriptor to the backend the caller asked for. Given `discarded`, first empties the receive
+// queue and stores how many datagrams that threw away.
+static std::expected<std::unique_ptr<Socket>, ErrorCode> makeSocket(int sockfd, const SocketConfig& config, size_t* discarded = nullptr) {
+    auto socket = std::make_unique<SocketUnix>(sockfd, config.rx_timestamps || config.rx_drop_counter, config.max_datagram_size);
+    if (discarded != nullptr) {
+        *discarded = socket->discardQueued();
+    }
+    if (config.backend == SocketBackend::IoUring) {
+        return WrapUringSocket(std::move(socket), config);
+    }
+    return socket;
+}
+
+std::expected<std::unique_ptr<Socket>, ErrorCode> Listen(const Addr& bindAddr) {
+    return Listen(bindAddr, SocketConfig{});
+}
+
+std::expected<std::unique_ptr<Socket>, ErrorCode> Listen(const Addr& bindAddr, const SocketConfig& config) {
+    auto sockfd = openListenSocket(bindAddr, config);
+    if (!sockfd) {
+        return std::unexpected(sockfd.error());
+    }
+
+    return makeSocket(*sockfd, config);
+}
+
+#if defined(__linux__)
+// Builds the classic BPF program the reuseport group runs per datagram; its return value indexes the member sockets
+// in bind order. For UDP the kernel has already pulled the UDP header, so absolute loads address the payload.
+// Out-of-range indexes fall back to the flow hash; a load past the end of a short datagram selects socket 0.
+static std::expected<void, ErrorCode> attachSteeringProgram(int sockfd, const ListenGroupConfig& config, size_t count) {
+    sock_filter load{};
+    switch (config.steering) {
+    case ListenSteering::Cpu:
+        load = BPF_STMT(BPF_LD | BPF_W | BPF_ABS, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU));
+        break;
+    case ListenSteering::PayloadKey: {
+        uint16_t width = 0;
+        switch (config.steering_key_size) {
+        case 1: width = BPF_B; break;
+        case 2: width = BPF_H; break;
+        case 4: width = BPF_W; break;
+        default: return std::unexpected(ErrorCode::InvalidArgument);
+        }
+        if (config.steering_key_offset > static_cast<size_t>(kMaxDatagramSize)) {
+            return std::unexpected(ErrorCode::InvalidArgument);
+        }
+        load = BPF_STMT(BPF_LD | width | BPF_ABS, static_cast<uint32_t>(config.steering_key_offset));
+        break;
+    }
+    case ListenSteering::FlowHash:
+        return {};
+    }
+
+    sock_filter code[] = {
+        load,
+        BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, static_cast<uint32_t>(count)),
+        BPF_STMT(BPF_RET | BPF_A, 0)
+    };
+    sock_fprog prog{
+        .len = static_cast<unsigned short>(std::size(code)),
+        .filter = code
+    };
+
+    if (::setsockopt(sockfd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog)) < 0) {
+        return std::unexpected(ErrorCode::SocketConfigFailed);
+    }
+    return {};
+}
+#endif
+
+std::expected<std::vector<std::unique_ptr<Socket>>, ErrorCode> ListenGroup(const Addr& bindAddr, const ListenGroupConfig& config) {
+    const size_t cpuCount = std::max(1u, std::thread::hardware_concurrency());
+    const size_t count = (config.socket_count == 0) ? cpuCount : config.socket_count;
+
+#if !defined(__linux__)
+    // Only Linux balances datagrams across SO_REUSEPORT sockets; elsewhere extra members would never see traffic
+    if (count > 1 || config.steering != ListenSteering::FlowHash) {
+        return std::unexpected(ErrorCode::NotSupported);
+    }
+#endif
+
+    std::vector<std::unique_ptr<Socket>> group;
+    group.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        SocketConfig memberConfig = config.socket;
+        memberConfig.reuse_port = true;
+        if (config.pin_to_cpu) {
+            memberConfig.incoming_cpu = static_cast<int>(i % cpuCount);
+        }
+
+        auto sockfd = openListenSocket(bindAddr, memberConfig);
+        if (!sockfd) {
+            return std::unexpected(sockfd.error()); // members opened so far close with `group`
+        }
+
+        auto member = makeSocket(*sockfd, memberConfig);
+        if (!member) {
+            return std::unexpected(member.error());
+        }
+        group.push_back(std::move(*member));
+
+#if defined(__linux__)
+        // Attach through the first member before the rest join, so no datagram is ever hashed across a partial group
+        if (i == 0) {
+            if (auto attached = attachSteeringProgram(*sockfd, config, count); !attached) {
+                return std::unexpected(attached.error());
+            }
+        }
+#endif
+    }
+
+    return group;
+}
+
+std::expected<void, ErrorCode> PinCurrentThread(size_t cpu) {
+#if defined(__linux__)
+    if (cpu >= CPU_SETSIZE) {
+        return std::unexpected(ErrorCode::InvalidArgument);
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) != 0) {
+        return std::unexpected(ErrorCode::InvalidArgument);
+    }
+    return {};
+#else
+    (void)cpu;
+    return std::unexpected(ErrorCode::NotSupported);
+#endif
 }
 
 std::expected<std::unique_ptr<Socket>, ErrorCode> Dial(const Addr& remoteAddr) {
+    return Dial(remoteAddr, SocketConfig{});
+}
+
+std::expected<std::unique_ptr<Socket>, ErrorCode> Dial(const Addr& remoteAddr, const SocketConfig& config) {
     int family = AF_INET;
     sockaddr_storage remoteSock{};
     socklen_t remoteLen = 0;
@@ -235,12 +1118,81 @@ std::expected<std::unique_ptr<Socket>, ErrorCode> Dial(const Addr& remoteAddr) {
         return std::unexpected(ErrorCode::SocketConfigFailed);
     }
 
+    if (auto applied = applySocketOptions(sockfd, family, config); !applied) {
+        ::close(sockfd);
+        return std::unexpected(applied.error());
+    }
+
     if (connect(sockfd, reinterpret_cast<sockaddr*>(&remoteSock), remoteLen) < 0) {
         ::close(sockfd);
         return std::unexpected(ErrorCode::ConnectFailed);
     }
 
-    return std::make_unique<SocketUnix>(sockfd);
+    return makeSocket(sockfd, config);
+}
+
+std::expected<PeerSession, ErrorCode> PeerSession::Open(Socket& listener, const Endpoint& peer, const PeerSessionConfig& config) {
+    auto local = listener.localEndpoint();
+    if (!local) {
+        return std::unexpected(local.error());
+    }
+    if (!peer.isSpecified() || peer.port() == 0 || peer.family() != local->family()) {
+        return std::unexpected(ErrorCode::InvalidAddress);
+    }
+
+    if (!config.connected) {
+        return PeerSession(listener, peer, nullptr);
+    }
+
+#if defined(__linux__)
+    sockaddr_storage localSock{};
+    sockaddr_storage peerSock{};
+    const auto localLen = static_cast<socklen_t>(local->toSockaddr(&localSock));
+    const auto peerLen = static_cast<socklen_t>(peer.toSockaddr(&peerSock));
+    const int family = local->isV4() ? AF_INET : AF_INET6;
+
+    int sockfd = ::socket(family, SOCK_DGRAM, 0);
+    if (sockfd < 0) {
+        return std::unexpected(ErrorCode::SocketCreateFailed);
+    }
+
+    // Make socket non-blocking
+    int flags = fcntl(sockfd, F_GETFL, 0);
+    if (flags < 0 || fcntl(sockfd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        ::close(sockfd);
+        return std::unexpected(ErrorCode::SocketConfigFailed);
+    }
+
+    SocketConfig socketConfig = config.socket;
+    socketConfig.reuse_port = true;
+    if (auto applied = applySocketOptions(sockfd, family, socketConfig); !applied) {
+        ::close(sockfd);
+        return std::unexpected(applied.error());
+    }
+
+    // Joins the listener's reuseport group; once connected, the kernel scores this socket above the
+    // unconnected members for the peer's 4-tuple
+    if (::bind(sockfd, reinterpret_cast<const sockaddr*>(&localSock), localLen) < 0) {
+        ::close(sockfd);
+        return std::unexpected(ErrorCode::BindFailed);
+    }
+    if (::connect(sockfd, reinterpret_cast<const sockaddr*>(&peerSock), peerLen) < 0) {
+        ::close(sockfd);
+        return std::unexpected(ErrorCode::ConnectFailed);
+    }
+
+    // Until connect() took effect the group could hash other peers' datagrams here. A socket cannot hand them back to
+    // the listener's queue, and no filter keeps them out either: the reuseport pick happens before any filter runs.
+    // They are discarded, and counted in PeerSession::discarded() as well as the socket's SocketMetrics::dropped
+    size_t discarded = 0;
+    auto socket = makeSocket(sockfd, socketConfig, &discarded);
+    if (!socket) {
+        return std::unexpected(socket.error());
+    }
+    return PeerSession(listener, peer, std::move(*socket), discarded);
+#else
+    return std::unexpected(ErrorCode::NotSupported);
+#endif
 }
 
 } // namespace pulse::net::udp
@@ -0,0 +1,830 @@
+#include "udp_uring.h"
+#include "socket_metrics.h"
+
+#if defined(__linux__)
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <ctime>
+#include <unistd.h>
+#include <errno.h>
+#include <atomic>
+#include <cstring>
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+namespace pulse::net::udp {
+
+namespace {
+
+// Receive slots handed to the kernel through the provided buffer ring (power of two)
+constexpr unsigned kRecvBufferCount = 128;
+
+// Control space for an SCM_TIMESTAMPNS plus an SO_RXQ_OVFL message
+constexpr size_t kRecvControlSize = 64;
+
+// Each slot holds io_uring_recvmsg_out, the source sockaddr, control messages, then SocketConfig::max_datagram_size
+// payload bytes; jumbo configurations therefore cost kRecvBufferCount times that in slot memory
+constexpr size_t kRecvSlotHeaderSize = sizeof(io_uring_recvmsg_out) + sizeof(sockaddr_storage) + kRecvControlSize;
+
+constexpr uint16_t kRecvBufferGroup = 0;
+constexpr uint64_t kRecvTag = UINT64_MAX;
+constexpr uint64_t kCancelTag = UINT64_MAX - 1;
+
+int uringSetup(unsigned entries, io_uring_params* params) {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int uringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+int uringRegister(int fd, unsigned opcode, void* arg, unsigned count) {
+    return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+std::unexpected<ErrorCode> mapSendResult(int err) {
+    switch (err) {
+        case EWOULDBLOCK:
+            return std::unexpected(ErrorCode::WouldBlock);
+        case EBADF:
+        case ENOTSOCK:
+            return std::unexpected(ErrorCode::InvalidSocket);
+        case ECONNRESET:
+            return std::unexpected(ErrorCode::ConnectionReset);
+        default:
+            return std::unexpected(ErrorCode::SendFailed);
+    }
+}
+
+// One io_uring instance driven without liburing: SQ/CQ rings mapped from the kernel, filled and drained here.
+class Ring {
+public:
+    Ring() = default;
+    Ring(const Ring&) = delete;
+    Ring& operator=(const Ring&) = delete;
+
+    ~Ring() {
+        reset();
+    }
+
+    std::expected<void, ErrorCode> init(unsigned sqEntries, unsigned cqEntries) {
+        io_uring_params params{};
+        params.flags = IORING_SETUP_CQSIZE;
+        params.cq_entries = cqEntries;
+
+        fd_ = uringSetup(sqEntries, &params);
+        if (fd_ < 0) {
+            fd_ = -1;
+            return std::unexpected(ErrorCode::NotSupported);
+        }
+        if (!(params.features & IORING_FEAT_SINGLE_MMAP)) {
+            return std::unexpected(ErrorCode::NotSupported);
+        }
+
+        const size_t sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        const size_t cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        ring_len_ = std::max(sqSize, cqSize);
+        ring_ = ::mmap(nullptr, ring_len_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+        if (ring_ == MAP_FAILED) {
+            ring_ = nullptr;
+            return std::unexpected(ErrorCode::SocketConfigFailed);
+        }
+
+        sqes_len_ = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = ::mmap(nullptr, sqes_len_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) {
+            return std::unexpected(ErrorCode::SocketConfigFailed);
+        }
+        sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+        auto* base = static_cast<uint8_t*>(ring_);
+        sq_head_ = reinterpret_cast<unsigned*>(base + params.sq_off.head);
+        sq_tail_ = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+        sq_entries_ = params.sq_entries;
+        cq_head_ = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(base + params.cq_off.cqes);
+
+        // The SQ index array stays an identity map; SQEs are always used in ring order
+        auto* array = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+        for (unsigned i = 0; i < sq_entries_; ++i) {
+            array[i] = i;
+        }
+        return {};
+    }
+
+    void reset() {
+        if (sqes_ != nullptr) {
+            ::munmap(sqes_, sqes_len_);
+            sqes_ = nullptr;
+        }
+        if (ring_ != nullptr) {
+            ::munmap(ring_, ring_len_);
+            ring_ = nullptr;
+        }
+        if (fd_ != -1) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    int fd() const { return fd_; }
+
+    // Zeroed SQE at the local tail; becomes visible to the kernel on submit()
+    io_uring_sqe* nextSqe() {
+        const unsigned head = std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire);
+        if (local_tail_ - head >= sq_entries_) {
+            return nullptr;
+        }
+        io_uring_sqe* sqe = &sqes_[local_tail_ & sq_mask_];
+        std::memset(sqe, 0, sizeof(*sqe));
+        local_tail_++;
+        return sqe;
+    }
+
+    // Publishes queued SQEs and optionally waits for `minComplete` completions. Returns the kernel's result.
+    int submit(unsigned minComplete) {
+        const unsigned head = std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire);
+        const unsigned pending = local_tail_ - head;
+        std::atomic_ref<unsigned>(*sq_tail_).store(local_tail_, std::memory_order_release);
+
+        int ret;
+        do {
+            ret = uringEnter(fd_, pending, minComplete, minComplete > 0 ? IORING_ENTER_GETEVENTS : 0);
+        } while (ret < 0 && errno == EINTR);
+        return ret;
+    }
+
+    // Takes back SQEs queued since the last submit() that the kernel did not consume
+    void discardUnsubmitted() {
+        local_tail_ = std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire);
+        std::atomic_ref<unsigned>(*sq_tail_).store(local_tail_, std::memory_order_release);
+    }
+
+    int waitCqe() {
+        int ret;
+        do {
+            ret = uringEnter(fd_, 0, 1, IORING_ENTER_GETEVENTS);
+        } while (ret < 0 && errno == EINTR);
+        return ret;
+    }
+
+    const io_uring_cqe* peekCqe() const {
+        const unsigned head = *cq_head_;
+        const unsigned tail = std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+        return head == tail ? nullptr : &cqes_[head & cq_mask_];
+    }
+
+    void popCqe() {
+        std::atomic_ref<unsigned>(*cq_head_).store(*cq_head_ + 1, std::memory_order_release);
+    }
+
+private:
+    int fd_ = -1;
+    void* ring_ = nullptr;
+    size_t ring_len_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    size_t sqes_len_ = 0;
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned sq_entries_ = 0;
+    unsigned local_tail_ = 0;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+};
+
+// Receives through one multishot recvmsg that stays armed on the socket, landing datagrams in a provided buffer ring;
+// sends queue one linked SENDMSG per datagram and submit the whole batch with a single io_uring_enter().
+// getHandle() reports the receive ring's fd, which polls readable while completions are waiting, so Poller works unchanged.
+// sendSegmented() queues one UDP_SEGMENT SENDMSG per GSO chunk on the same send ring; GRO is not offered on this backend.
+// Every socket owns its rings: two io_uring fds (so three fds per socket with the socket itself), their SQ/CQ/SQE
+// mappings, and kRecvBufferCount receive slots of max_datagram_size plus a header each (about 300 KiB at the default
+// size). That keeps each socket lock-free and independent of threads, and suits a few busy sockets, not one per peer.
+class SocketUring : public Socket {
+public:
+    SocketUring(std::unique_ptr<Socket> socket, int sockfd, bool rxControl, size_t maxDatagram)
+        : socket_(std::move(socket)), sockfd_(sockfd), rx_control_(rxControl), max_datagram_(maxDatagram),
+          // Round the stride up to a cache line so every slot's recvmsg_out header and sockaddr stay aligned
+          // whatever max_datagram_size is
+          slot_size_((kRecvSlotHeaderSize + maxDatagram + 63) & ~size_t{63}) {}
+
+    ~SocketUring() override {
+        close();
+    }
+
+    std::expected<void, ErrorCode> init() {
+        if (auto ok = recv_ring_.init(4, kRecvBufferCount * 2); !ok) {
+            return ok;
+        }
+        if (auto ok = send_ring_.init(static_cast<unsigned>(kMaxSendBatch), static_cast<unsigned>(kMaxSendBatch) * 2); !ok) {
+            return ok;
+        }
+
+        const size_t ringBytes = kRecvBufferCount * sizeof(io_uring_buf);
+        buf_ring_len_ = (ringBytes + 4095) & ~static_cast<size_t>(4095);
+        void* mem = ::mmap(nullptr, buf_ring_len_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mem == MAP_FAILED) {
+            return std::unexpected(ErrorCode::SocketConfigFailed);
+        }
+        buf_ring_ = static_cast<io_uring_buf_ring*>(mem);
+
+        io_uring_buf_reg reg{};
+        reg.ring_addr = reinterpret_cast<uint64_t>(buf_ring_);
+        reg.ring_entries = kRecvBufferCount;
+        reg.bgid = kRecvBufferGroup;
+        if (uringRegister(recv_ring_.fd(), IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+            return std::unexpected(ErrorCode::NotSupported);
+        }
+
+        recv_msg_.msg_namelen = sizeof(sockaddr_storage);
+        recv_msg_.msg_controllen = rx_control_ ? kRecvControlSize : 0;
+
+        // The kernel fills whatever follows the header, so lend exactly max_datagram_size payload bytes per slot
+        slot_len_ = sizeof(io_uring_recvmsg_out) + recv_msg_.msg_namelen + recv_msg_.msg_controllen + max_datagram_;
+        slots_ = std::make_unique_for_overwrite<uint8_t[]>(kRecvBufferCount * slot_size_);
+        for (uint16_t bid = 0; bid < kRecvBufferCount; ++bid) {
+            provideBuffer(bid);
+        }
+        publishBuffers();
+        return armRecv();
+    }
+
+    std::expected<void, ErrorCode> sendTo(const Addr& addr, const uint8_t* data, size_t length) override {
+        return sendTo(Endpoint::FromAddr(addr), data, length);
+    }
+
+    std::expected<void, ErrorCode> sendTo(const Endpoint& addr, const uint8_t* data, size_t length) override {
+        if (!addr.isSpecified()) {
+            return std::unexpected(ErrorCode::InvalidAddress);
+        }
+        return sendOne(OutgoingPacket{.addr = addr, .data = data, .length = length});
+    }
+
+    std::expected<void, ErrorCode> send(const uint8_t* data, size_t length) override {
+        return sendOne(OutgoingPacket{.addr = Endpoint{}, .data = data, .length = length});
+    }
+
+    std::expected<size_t, ErrorCode> sendBatch(std::span<const OutgoingPacket> packets) override {
+        size_t accepted = 0;
+        while (accepted < packets.size()) {
+            const size_t count = std::min(packets.size() - accepted, kMaxSendBatch);
+            auto sent = submitSends(packets.subspan(accepted, count));
+            if (!sent) {
+                if (accepted > 0) {
+                    break;
+                }
+                return std::unexpected(sent.error());
+            }
+
+            accepted += *sent;
+            if (*sent < count) {
+                break;
+            }
+        }
+
+        return accepted;
+    }
+
+    std::expected<size_t, ErrorCode> sendSegmented(const Endpoint& addr, const uint8_t* data, size_t length, size_t segmentSize) override {
+        if (segmentSize == 0) {
+            return std::unexpected(ErrorCode::InvalidArgument);
+        }
+
+        const size_t chunkLimit = std::min(kMaxGsoSegments, std::max<size_t>(1, kMaxGsoBytes / segmentSize)) * segmentSize;
+        size_t accepted = 0;
+        size_t offset = 0;
+
+        while (gso_supported_ && offset < length) {
+            OutgoingPacket chunks[kMaxSendBatch];
+            size_t count = 0;
+            for (size_t cursor = offset; count < kMaxSendBatch && cursor < length; ++count) {
+                const size_t chunkBytes = std::min(chunkLimit, length - cursor);
+                chunks[count] = OutgoingPacket{.addr = addr, .data = data + cursor, .length = chunkBytes};
+                cursor += chunkBytes;
+            }
+
+            auto sent = submitSends(std::span<const OutgoingPacket>(chunks, count), segmentSize);
+            if (!sent) {
+                if (sent.error() == ErrorCode::NotSupported) {
+                    break; // no usable GSO; send segment by segment below
+                }
+                if (accepted == 0) {
+                    return std::unexpected(sent.error());
+                }
+                return accepted;
+            }
+
+            for (size_t i = 0; i < *sent; ++i) {
+                offset += chunks[i].length;
+                accepted += (chunks[i].length + segmentSize - 1) / segmentSize;
+            }
+            if (*sent < count) {
+                return accepted;
+            }
+        }
+
+        // Fallback: one SENDMSG per segment
+        while (offset < length) {
+            OutgoingPacket packets[kMaxSendBatch];
+            size_t count = 0;
+            for (size_t cursor = offset; count < kMaxSendBatch && cursor < length; ++count) {
+                const size_t segmentBytes = std::min(segmentSize, length - cursor);
+                packets[count] = OutgoingPacket{.addr = addr, .data = data + cursor, .length = segmentBytes};
+                cursor += segmentBytes;
+            }
+
+            auto sent = submitSends(std::span<const OutgoingPacket>(packets, count));
+            if (!sent) {
+                if (accepted == 0) {
+                    return std::unexpected(sent.error());
+                }
+                break;
+            }
+
+            for (size_t i = 0; i < *sent; ++i) {
+                offset += packets[i].length;
+            }
+            accepted += *sent;
+            if (*sent < count) {
+                break;
+            }
+        }
+
+        return accepted;
+    }
+
+    std::expected<ReceivedPacket, ErrorCode> recvFrom() override {
+        recycleLent();
+        return nextPacket();
+    }
+
+    std::expected<ReceivedPacket, ErrorCode> recvFrom(std::span<uint8_t> buffer) override {
+        recycleLent();
+        auto packet = nextPacket();
+        if (!packet) {
+            return packet;
+        }
+
+        const size_t length = std::min(packet->length, buffer.size());
+        std::memcpy(buffer.data(), packet->data, length);
+        recycleLent();
+        return ReceivedPacket{
+            .data = buffer.data(),
+            .length = length,
+            .addr = packet->addr,
+            .rx_timestamp_ns = packet->rx_timestamp_ns,
+            .drops = packet->drops,
+            .truncated = packet->truncated || packet->length > buffer.size(),
+            .datagram_length = packet->datagram_length
+        };
+    }
+
+    std::expected<void, ErrorCode> recvInto(PacketBuffer& packet) override {
+        auto storage = packet.storage();
+        auto received = recvFrom(storage);
+        if (!received) {
+            return std::unexpected(received.error());
+        }
+
+        packet.setAddr(received->addr);
+        packet.setTruncated(received->truncated);
+        return packet.resize(received->length);
+    }
+
+    std::expected<size_t, ErrorCode> recvBatch(std::span<ReceivedPacket> packets) override {
+        recycleLent();
+
+        const size_t limit = std::min(packets.size(), kMaxRecvBatch);
+        size_t filled = 0;
+        while (filled < limit) {
+            auto packet = nextPacket();
+            if (!packet) {
+                if (packet.error() == ErrorCode::WouldBlock) {
+                    break;
+                }
+                if (filled == 0) {
+                    return std::unexpected(packet.error());
+                }
+                break;
+            }
+            packets[filled++] = *packet;
+        }
+
+        if (filled == 0) {
+            return std::unexpected(ErrorCode::WouldBlock);
+        }
+        return filled;
+    }
+
+    std::expected<void, ErrorCode> enableGro() override {
+        // Merged GRO payloads would not fit the fixed-size provided buffers
+        return std::unexpected(ErrorCode::NotSupported);
+    }
+
+    std::expected<CoalescedPacket, ErrorCode> recvCoalesced() override {
+        return std::unexpected(ErrorCode::NotSupported);
+    }
+
+    std::expected<SocketMetrics, ErrorCode> metrics() const override {
+        // Sends and receives here bypass the wrapped socket, so this backend keeps its own counters; datagrams the
+        // wrapped socket discarded before the switch (a PeerSession's stray datagrams) still count as dropped
+        auto snapshot = metrics_.snapshot();
+        if (auto wrapped = socket_->metrics(); snapshot && wrapped) {
+            snapshot->dropped += wrapped->dropped;
+        }
+        return snapshot;
+    }
+
+    std::expected<SocketConfig, ErrorCode> effectiveConfig() const override {
+        auto config = socket_->effectiveConfig();
+        if (config) {
+            config->backend = SocketBackend::IoUring;
+        }
+        return config;
+    }
+
+    std::expected<Endpoint, ErrorCode> localEndpoint() const override {
+        return socket_->localEndpoint();
+    }
+
+    std::expected<int, ErrorCode> getHandle() const override {
+        if (recv_ring_.fd() == -1) {
+            return std::unexpected(ErrorCode::InvalidSocket);
+        }
+        return recv_ring_.fd();
+    }
+
+    void close() override {
+        cancelRecv();
+        recv_ring_.reset();
+        send_ring_.reset();
+        if (buf_ring_ != nullptr) {
+            ::munmap(buf_ring_, buf_ring_len_);
+            buf_ring_ = nullptr;
+        }
+        socket_->close();
+    }
+
+private:
+    void provideBuffer(uint16_t bid) {
+        const uint16_t mask = kRecvBufferCount - 1;
+        // Index from the ring base: in C++ the header's flexible-array wrapper shifts `bufs` off offset 0
+        io_uring_buf& buf = reinterpret_cast<io_uring_buf*>(buf_ring_)[(buf_tail_ + buf_pending_) & mask];
+        buf.addr = reinterpret_cast<uint64_t>(slots_.get() + bid * slot_size_);
+        buf.len = static_cast<uint32_t>(slot_len_);
+        buf.bid = bid;
+        buf_pending_++;
+    }
+
+    void publishBuffers() {
+        buf_tail_ = static_cast<uint16_t>(buf_tail_ + buf_pending_);
+        buf_pending_ = 0;
+        std::atomic_ref<uint16_t>(buf_ring_->tail).store(buf_tail_, std::memory_order_release);
+    }
+
+    std::expected<void, ErrorCode> armRecv() {
+        io_uring_sqe* sqe = recv_ring_.nextSqe();
+        if (sqe == nullptr) {
+            return std::unexpected(ErrorCode::SocketConfigFailed);
+        }
+        sqe->opcode = IORING_OP_RECVMSG;
+        sqe->fd = sockfd_;
+        sqe->addr = reinterpret_cast<uint64_t>(&recv_msg_);
+        sqe->len = 1;
+        sqe->flags = IOSQE_BUFFER_SELECT;
+        sqe->buf_group = kRecvBufferGroup;
+        sqe->ioprio = IORING_RECV_MULTISHOT;
+        sqe->msg_flags = MSG_TRUNC; // io_uring_recvmsg_out::payloadlen then carries the full size of a cut datagram
+        sqe->user_data = kRecvTag;
+
+        if (recv_ring_.submit(0) < 0) {
+            return std::unexpected(errno == EINVAL ? ErrorCode::NotSupported : ErrorCode::SocketConfigFailed);
+        }
+        armed_ = true;
+        return {};
+    }
+
+    // The armed receive holds its own reference to the socket, and ring teardown releases it asynchronously;
+    // cancelling and reaping it first means the port is free by the time close() returns.
+    void cancelRecv() {
+        if (!armed_ || recv_ring_.fd() == -1) {
+            return;
+        }
+
+        io_uring_sqe* sqe = recv_ring_.nextSqe();
+        if (sqe == nullptr) {
+            return;
+        }
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->addr = kRecvTag;
+        sqe->user_data = kCancelTag;
+        if (recv_ring_.submit(0) < 0) {
+            return;
+        }
+
+        while (armed_) {
+            const io_uring_cqe* cqe = recv_ring_.peekCqe();
+            if (cqe == nullptr) {
+                if (recv_ring_.waitCqe() < 0) {
+                    return;
+                }
+                continue;
+            }
+            if (cqe->user_data == kRecvTag && !(cqe->flags & IORING_CQE_F_MORE)) {
+                armed_ = false;
+            }
+            recv_ring_.popCqe();
+        }
+    }
+
+    // Hands back every slot the previous receive call lent out; their data pointers are now dead
+    void recycleLent() {
+        if (lent_count_ == 0) {
+            return;
+        }
+        for (size_t i = 0; i < lent_count_; ++i) {
+            provideBuffer(lent_[i]);
+        }
+        lent_count_ = 0;
+        publishBuffers();
+    }
+
+    // Next datagram from the completion queue. Its slot stays lent out, and `data` valid, until recycleLent().
+    std::expected<ReceivedPacket, ErrorCode> nextPacket() {
+        if (recv_ring_.fd() == -1) {
+            return std::unexpected(ErrorCode::InvalidSocket);
+        }
+
+        while (const io_uring_cqe* cqe = recv_ring_.peekCqe()) {
+            const uint64_t tag = cqe->user_data;
+            const int res = cqe->res;
+            const uint32_t flags = cqe->flags;
+            recv_ring_.popCqe();
+
+            if (tag != kRecvTag) {
+                continue;
+            }
+            if (!(flags & IORING_CQE_F_MORE)) {
+                armed_ = false; // terminated: out of buffers, cancelled, or failed
+            }
+            if (!(flags & IORING_CQE_F_BUFFER)) {
+                continue;
+            }
+
+            const auto bid = static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+            uint8_t* slot = slots_.get() + bid * slot_size_;
+            auto packet = parseSlot(slot, res);
+            if (!packet) {
+                // Undecodable sender, dropped like the syscall backend does; the slot goes straight back to the kernel
+                provideBuffer(bid);
+                publishBuffers();
+                metrics_.dropped();
+                continue;
+            }
+
+            // Only delivered datagrams stay lent, and no receive call hands out more than kMaxRecvBatch
+            assert(lent_count_ < std::size(lent_));
+            lent_[lent_count_++] = bid;
+            metrics_.receivedAsync(1, packet->length);
+            return packet;
+        }
+
+        if (!armed_) {
+            if (auto rearmed = armRecv(); !rearmed) {
+                return std::unexpected(rearmed.error());
+            }
+        }
+        return std::unexpected(ErrorCode::WouldBlock);
+    }
+
+    std::expected<ReceivedPacket, ErrorCode> parseSlot(const uint8_t* slot, int res) {
+        const size_t header = sizeof(io_uring_recvmsg_out) + recv_msg_.msg_namelen + recv_msg_.msg_controllen;
+        if (res < static_cast<int>(header)) {
+            return std::unexpected(ErrorCode::RecvFailed);
+        }
+
+        io_uring_recvmsg_out out;
+        std::memcpy(&out, slot, sizeof(out));
+        if (out.flags & MSG_TRUNC) {
+            metrics_.truncated();
+        }
+        if (out.namelen > recv_msg_.msg_namelen) {
+            return std::unexpected(ErrorCode::UnsupportedAddressFamily);
+        }
+
+        Endpoint addr = Endpoint::FromSockaddr(slot + sizeof(io_uring_recvmsg_out));
+        if (!addr.isSpecified() || addr.port() == 0) {
+            return std::unexpected(ErrorCode::InvalidAddress);
+        }
+
+        ReceivedPacket packet{
+            .data = slot + header,
+            .length = static_cast<size_t>(res) - header,
+            .addr = addr,
+            .truncated = (out.flags & MSG_TRUNC) != 0,
+            .datagram_length = out.payloadlen
+        };
+
+        if (out.controllen > 0) {
+            // Walk the control block the kernel wrote after the name, through a msghdr that describes just that span
+            msghdr control{};
+            control.msg_control = const_cast<uint8_t*>(slot + sizeof(io_uring_recvmsg_out) + recv_msg_.msg_namelen);
+            control.msg_controllen = std::min<size_t>(out.controllen, recv_msg_.msg_controllen);
+            for (const cmsghdr* cmsg = CMSG_FIRSTHDR(&control); cmsg != nullptr; cmsg = CMSG_NXTHDR(&control, const_cast<cmsghdr*>(cmsg))) {
+                if (cmsg->cmsg_level != SOL_SOCKET) {
+                    continue;
+                }
+                if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+                    timespec ts;
+                    std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+                    packet.rx_timestamp_ns = static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000 + static_cast<uint64_t>(ts.tv_nsec);
+                } else if (cmsg->cmsg_type == SO_RXQ_OVFL) {
+                    std::memcpy(&packet.drops, CMSG_DATA(cmsg), sizeof(packet.drops));
+                }
+            }
+        }
+
+        return packet;
+    }
+
+    std::expected<void, ErrorCode> sendOne(const OutgoingPacket& packet) {
+        auto sent = submitSends(std::span<const OutgoingPacket>(&packet, 1));
+        if (!sent) {
+            return std::unexpected(sent.error());
+        }
+        return {};
+    }
+
+    // Queues up to kMaxSendBatch linked SENDMSGs, so a failure cancels everything after it and the accepted
+    // count is a prefix, exactly like sendmmsg(). MSG_DONTWAIT makes a full send buffer complete with EAGAIN
+    // instead of parking the request, so waiting for every completion never blocks.
+    // A nonzero `segmentSize` makes each packet longer than it a GSO chunk the kernel splits into segmentSize
+    // datagrams; if the first chunk is refused for lack of GSO, NotSupported comes back unrecorded so the caller can fall back.
+    std::expected<size_t, ErrorCode> submitSends(std::span<const OutgoingPacket> packets, size_t segmentSize = 0) {
+        if (send_ring_.fd() == -1) {
+            return std::unexpected(ErrorCode::InvalidSocket);
+        }
+
+        const size_t count = packets.size();
+        for (size_t i = 0; i < count; ++i) {
+            send_iovs_[i].iov_base = const_cast<uint8_t*>(packets[i].data);
+            send_iovs_[i].iov_len = packets[i].length;
+            send_msgs_[i] = msghdr{};
+            if (packets[i].addr.isSpecified()) {
+                send_msgs_[i].msg_name = &send_dsts_[i];
+                send_msgs_[i].msg_namelen = static_cast<socklen_t>(packets[i].addr.toSockaddr(&send_dsts_[i]));
+            }
+            send_msgs_[i].msg_iov = &send_iovs_[i];
+            send_msgs_[i].msg_iovlen = 1;
+            if (segmentSize != 0 && packets[i].length > segmentSize) {
+                send_msgs_[i].msg_control = send_controls_[i];
+                send_msgs_[i].msg_controllen = sizeof(send_controls_[i]);
+                cmsghdr* cm = CMSG_FIRSTHDR(&send_msgs_[i]);
+                cm->cmsg_level = IPPROTO_UDP;
+                cm->cmsg_type = UDP_SEGMENT;
+                cm->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+                const uint16_t gsoSize = static_cast<uint16_t>(segmentSize);
+                std::memcpy(CMSG_DATA(cm), &gsoSize, sizeof(gsoSize));
+            }
+
+            io_uring_sqe* sqe = send_ring_.nextSqe();
+            sqe->opcode = IORING_OP_SENDMSG;
+            sqe->fd = sockfd_;
+            sqe->addr = reinterpret_cast<uint64_t>(&send_msgs_[i]);
+            sqe->len = 1;
+            sqe->msg_flags = MSG_DONTWAIT;
+            sqe->flags = (i + 1 < count) ? IOSQE_IO_LINK : 0;
+            sqe->user_data = i;
+        }
+
+        const uint64_t start = metrics_.start();
+        // Completions are reaped below rather than awaited here: asking the kernel to wait for more than it took would never return
+        const int submitted = send_ring_.submit(0);
+        if (submitted <= 0) {
+            send_ring_.discardUnsubmitted();
+            return metrics_.sendError(std::unexpected(ErrorCode::SendFailed));
+        }
+
+        // The kernel may stop short of the batch; what it did not take is not accepted, and only what it took completes
+        const size_t inFlight = std::min(count, static_cast<size_t>(submitted));
+        if (inFlight < count) {
+            send_ring_.discardUnsubmitted();
+        }
+
+        size_t accepted = inFlight;
+        int firstError = 0;
+        for (size_t reaped = 0; reaped < inFlight;) {
+            const io_uring_cqe* cqe = send_ring_.peekCqe();
+            if (cqe == nullptr) {
+                if (send_ring_.waitCqe() < 0) {
+                    return std::unexpected(ErrorCode::SendFailed);
+                }
+                continue;
+            }
+
+            const size_t index = static_cast<size_t>(cqe->user_data);
+            const int res = cqe->res;
+            send_ring_.popCqe();
+            reaped++;
+
+            const bool ok = res >= 0 && static_cast<size_t>(res) == packets[index].length;
+            if (!ok && index < accepted) {
+                accepted = index;
+                firstError = res < 0 ? -res : 0;
+            }
+        }
+
+        if (accepted == 0) {
+            if (firstError == 0) {
+                return metrics_.sendError(std::unexpected(ErrorCode::PartialSend));
+            }
+            const bool gsoRefused = firstError == EIO || firstError == ENOPROTOOPT || firstError == EOPNOTSUPP || firstError == EINVAL;
+            if (segmentSize != 0 && packets[0].length > segmentSize && gsoRefused) {
+                // EINVAL may just mean this segment size, so only the other errors rule GSO out for good
+                if (firstError != EINVAL) {
+                    gso_supported_ = false;
+                }
+                return std::unexpected(ErrorCode::NotSupported);
+            }
+            return metrics_.sendError(mapSendResult(firstError));
+        }
+
+        size_t sentDatagrams = 0;
+        size_t sentBytes = 0;
+        for (size_t i = 0; i < accepted; ++i) {
+            sentDatagrams += segmentSize != 0 ? (packets[i].length + segmentSize - 1) / segmentSize : 1;
+            sentBytes += packets[i].length;
+        }
+        metrics_.sent(start, sentDatagrams, sentBytes);
+        return accepted;
+    }
+
+    std::unique_ptr<Socket> socket_;
+    int sockfd_;
+    bool rx_control_;
+    size_t max_datagram_;
+    size_t slot_size_; // stride between slots
+    size_t slot_len_ = 0; // bytes of each slot lent to the kernel
+    MetricsRecorder metrics_;
+
+    Ring recv_ring_;
+    Ring send_ring_;
+
+    io_uring_buf_ring* buf_ring_ = nullptr;
+    size_t buf_ring_len_ = 0;
+    uint16_t buf_tail_ = 0;
+    uint16_t buf_pending_ = 0;
+    std::unique_ptr<uint8_t[]> slots_;
+    msghdr recv_msg_{};
+    bool armed_ = false;
+    uint16_t lent_[kMaxRecvBatch];
+    size_t lent_count_ = 0;
+
+    msghdr send_msgs_[kMaxSendBatch];
+    iovec send_iovs_[kMaxSendBatch];
+    sockaddr_storage send_dsts_[kMaxSendBatch];
+    alignas(cmsghdr) char send_controls_[kMaxSendBatch][CMSG_SPACE(sizeof(uint16_t))];
+    bool gso_supported_ = true; // cleared once the kernel refuses UDP_SEGMENT
+};
+
+} // namespace
+
+std::expected<std::unique_ptr<Socket>, ErrorCode> WrapUringSocket(std::unique_ptr<Socket> socket, const SocketConfig& config) {
+    auto handle = socket->getHandle();
+    if (!handle) {
+        return std::unexpected(handle.error());
+    }
+
+    auto uring = std::make_unique<SocketUring>(std::move(socket), *handle, config.rx_timestamps || config.rx_drop_counter, config.max_datagram_size);
+    if (auto ok = uring->init(); !ok) {
+        return std::unexpected(ok.error());
+    }
+    return uring;
+}
+
+} // namespace pulse::net::udp
+
+#else
+
+namespace pulse::net::udp {
+
+std::expected<std::unique_ptr<Socket>, ErrorCode> WrapUringSocket(std::unique_ptr<Socket> socket, const SocketConfig& config) {
+    (void)socket;
+    (void)config;
+    return std::unexpected(ErrorCode::NotSupported);
+}
+
+} // namespace pulse::net::udp
+
+#endif
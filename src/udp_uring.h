@@ -0,0 +1,14 @@
+#pragma once
+
+#include "pulse/net/udp/udp.h"
+#include <memory>
+#include <expected>
+
+namespace pulse::net::udp {
+
+// Moves a bound or connected non-blocking socket onto the io_uring backend (SocketBackend::IoUring).
+// `config` is the one the socket was opened with; its receive-side options shape the multishot request.
+// Returns NotSupported when the kernel lacks io_uring, provided buffer rings or multishot recvmsg.
+std::expected<std::unique_ptr<Socket>, ErrorCode> WrapUringSocket(std::unique_ptr<Socket> socket, const SocketConfig& config);
+
+} // namespace pulse::net::udp
@@ -1,4 +1,6 @@
 #include "pulse/net/udp/udp.h"
+#include "pulse/net/udp/listen_group.h"
+#include "pulse/net/udp/peer_session.h"
 #include <winsock2.h>
 #include <mswsock.h>
 #include <ws2tcpip.h>
@@ -8,6 +10,9 @@
 #include <memory>
 #include <atomic>
 #include <mutex>
+#include <algorithm>
+#include <climits>
+#include <thread>
 
 #pragma comment(lib, "ws2_32.lib")
 
@@ -15,6 +20,20 @@ namespace pulse::net::udp {
 
     constexpr size_t PACKET_BUFFER_SIZE = 2048;
 
+    // Grow-only thread-local receive space for sockets whose max_datagram_size exceeds PACKET_BUFFER_SIZE
+    struct JumboBuffer {
+        std::unique_ptr<uint8_t[]> storage;
+        size_t capacity = 0;
+
+        uint8_t* reserve(size_t bytes) {
+            if (capacity < bytes) {
+                storage = std::make_unique_for_overwrite<uint8_t[]>(bytes);
+                capacity = bytes;
+            }
+            return storage.get();
+        }
+    };
+
     static std::atomic<int> wsaRefCount{0};
     static std::mutex wsaMutex;
 
@@ -41,17 +60,11 @@ namespace pulse::net::udp {
         }
     }
 
-class SocketWindows : public Socket {
+class SocketWindows final : public Socket {
 public:
-    SocketWindows(SOCKET sock) : sock_(sock) {
-        // Increase socket buffer sizes but don't start receiving thread
-        int sendBufSize = 4 * 1024 * 1024; // 4MB
-        setsockopt(sock, SOL_SOCKET, SO_SNDBUF, (char*)&sendBufSize, sizeof(sendBufSize));
-        
-        // We still need a reasonable receive buffer for any responses
-        int recvBufSize = 1 * 1024 * 1024; // 1MB is enough for client
-        setsockopt(sock, SOL_SOCKET, SO_RCVBUF, (char*)&recvBufSize, sizeof(recvBufSize));
-        
+    SocketWindows(SOCKET sock, size_t maxDatagram = kDefaultMaxDatagramSize) : sock_(sock), max_datagram_(maxDatagram) {
+        // Buffer sizes are applied by applySocketOptions() before bind/connect
+
         // Disable connection reset behavior
         BOOL bNewBehavior = FALSE;
         DWORD dwBytesReturned = 0;
@@ -105,6 +118,34 @@ public:
         return {};
     }
 
+    std::expected<void, ErrorCode> sendTo(const Endpoint& addr, const uint8_t* data, size_t length) override {
+        sockaddr_storage dst;
+        size_t dstlen = addr.toSockaddr(&dst);
+        if (dstlen == 0) {
+            return std::unexpected(ErrorCode::InvalidAddress);
+        }
+
+        int sent = ::sendto(
+            sock_,
+            reinterpret_cast<const char*>(data),
+            static_cast<int>(length),
+            0,
+            reinterpret_cast<const sockaddr*>(&dst),
+            static_cast<int>(dstlen)
+        );
+
+        if (sent == SOCKET_ERROR) {
+            int err = WSAGetLastError();
+            return mapWSASendError(err);
+        }
+
+        if (sent != static_cast<int>(length)) {
+            return std::unexpected(ErrorCode::PartialSend);
+        }
+
+        return {};
+    }
+
     std::expected<void, ErrorCode> send(const uint8_t* data, size_t length) override {
         int sent = ::send(sock_, reinterpret_cast<const char*>(data), static_cast<int>(length), 0);
     
@@ -120,41 +161,238 @@ public:
         return {};
     }
 
+    std::expected<size_t, ErrorCode> sendBatch(std::span<const OutgoingPacket> packets) override {
+        // Winsock has no sendmmsg(); send one datagram at a time and stop at the first refusal
+        size_t accepted = 0;
+        for (const auto& packet : packets) {
+            sockaddr_storage dst;
+            size_t dstlen = packet.addr.toSockaddr(&dst);
+            int sent = ::sendto(
+                sock_,
+                reinterpret_cast<const char*>(packet.data),
+                static_cast<int>(packet.length),
+                0,
+                dstlen ? reinterpret_cast<const sockaddr*>(&dst) : nullptr,
+                static_cast<int>(dstlen)
+            );
+
+            if (sent == SOCKET_ERROR) {
+                int err = WSAGetLastError();
+                if (accepted == 0) {
+                    return mapWSASendError(err);
+                }
+                break;
+            }
+
+            ++accepted;
+        }
+
+        return accepted;
+    }
+
+    std::expected<size_t, ErrorCode> sendSegmented(const Endpoint& addr, const uint8_t* data, size_t length, size_t segmentSize) override {
+        if (segmentSize == 0) {
+            return std::unexpected(ErrorCode::InvalidArgument);
+        }
+
+        // No UDP GSO here; emit one datagram per segment through sendBatch()
+        size_t accepted = 0;
+        size_t offset = 0;
+        while (offset < length) {
+            OutgoingPacket packets[kMaxSendBatch];
+            size_t count = 0;
+            for (size_t cursor = offset; count < kMaxSendBatch && cursor < length; ++count) {
+                const size_t segmentBytes = std::min(segmentSize, length - cursor);
+                packets[count] = OutgoingPacket{.addr = addr, .data = data + cursor, .length = segmentBytes};
+                cursor += segmentBytes;
+            }
+
+            auto sent = sendBatch(std::span<const OutgoingPacket>(packets, count));
+            if (!sent) {
+                if (accepted == 0) {
+                    return std::unexpected(sent.error());
+                }
+                break;
+            }
+
+            for (size_t i = 0; i < *sent; ++i) {
+                offset += packets[i].length;
+            }
+            accepted += *sent;
+            if (*sent < count) {
+                break;
+            }
+        }
+
+        return accepted;
+    }
+
     std::expected<ReceivedPacket, ErrorCode> recvFrom() override {
         static thread_local uint8_t buf[PACKET_BUFFER_SIZE];
+        if (max_datagram_ <= PACKET_BUFFER_SIZE) {
+            return receiveInto(buf, max_datagram_);
+        }
+        static thread_local JumboBuffer jumbo;
+        return receiveInto(jumbo.reserve(max_datagram_), max_datagram_);
+    }
+
+    std::expected<ReceivedPacket, ErrorCode> recvFrom(std::span<uint8_t> buffer) override {
+        return receiveInto(buffer.data(), buffer.size());
+    }
+
+    std::expected<void, ErrorCode> recvInto(PacketBuffer& packet) override {
+        auto storage = packet.storage();
+        auto received = receiveInto(storage.data(), storage.size());
+        if (!received) {
+            return std::unexpected(received.error());
+        }
+
+        packet.setAddr(received->addr);
+        packet.setTruncated(received->truncated);
+        return packet.resize(received->length);
+    }
+
+    std::expected<size_t, ErrorCode> recvBatch(std::span<ReceivedPacket> packets) override {
+        static thread_local uint8_t bufs[kMaxRecvBatch][PACKET_BUFFER_SIZE];
+        const size_t count = std::min(packets.size(), kMaxRecvBatch);
+        size_t filled = 0;
+
+        // Slot i starts at base + i * stride
+        uint8_t* base = bufs[0];
+        size_t stride = PACKET_BUFFER_SIZE;
+        if (max_datagram_ > PACKET_BUFFER_SIZE) {
+            static thread_local JumboBuffer jumbo;
+            stride = max_datagram_;
+            base = jumbo.reserve(count * stride);
+        }
+
+        // Winsock has no recvmmsg(); drain with one recvfrom() per datagram
+        for (size_t i = 0; i < count; ++i) {
+            sockaddr_storage src{};
+            int srclen = sizeof(src);
+
+            int received = ::recvfrom(
+                sock_,
+                reinterpret_cast<char*>(base + i * stride),
+                static_cast<int>(max_datagram_),
+                0,
+                reinterpret_cast<sockaddr*>(&src),
+                &srclen
+            );
+
+            // WSAEMSGSIZE still fills the buffer and the sender; Winsock just does not say how long the datagram was
+            bool truncated = false;
+            if (received == SOCKET_ERROR) {
+                int err = WSAGetLastError();
+                if (err == WSAEMSGSIZE) {
+                    truncated = true;
+                    received = static_cast<int>(max_datagram_);
+                } else if (i == 0) {
+                    return mapWSARecvError(err);
+                } else {
+                    break;
+                }
+            }
+
+            auto addr = decodeAddr(reinterpret_cast<sockaddr*>(&src));
+            if (!addr || addr->port() == 0) {
+                continue;
+            }
+
+            packets[filled++] = ReceivedPacket{
+                .data = base + i * stride,
+                .length = static_cast<size_t>(received),
+                .addr = *addr,
+                .truncated = truncated,
+                .datagram_length = truncated ? 0 : static_cast<size_t>(received)
+            };
+        }
+
+        if (filled == 0 && count > 0) {
+            return std::unexpected(ErrorCode::WouldBlock); // everything pending was dropped
+        }
+        return filled;
+    }
+
+    std::expected<void, ErrorCode> enableGro() override {
+        return std::unexpected(ErrorCode::NotSupported);
+    }
+
+    std::expected<CoalescedPacket, ErrorCode> recvCoalesced() override {
+        // No GRO on Winsock; every receive is a single datagram, but large ones still need the full-size buffer
+        if (!coalesced_buf_) {
+            coalesced_buf_ = std::make_unique_for_overwrite<uint8_t[]>(kMaxCoalescedBytes);
+        }
+
         sockaddr_storage src{};
         int srclen = sizeof(src);
-    
+
         int received = ::recvfrom(
             sock_,
-            reinterpret_cast<char*>(buf),
-            sizeof(buf),
+            reinterpret_cast<char*>(coalesced_buf_.get()),
+            static_cast<int>(kMaxCoalescedBytes),
             0,
             reinterpret_cast<sockaddr*>(&src),
             &srclen
         );
-    
+
         if (received == SOCKET_ERROR) {
             int err = WSAGetLastError();
             return mapWSARecvError(err);
         }
-    
+
         auto addr = decodeAddr(reinterpret_cast<sockaddr*>(&src));
         if (!addr) {
             return std::unexpected(addr.error());
         }
-    
-        if (addr->port == 0) {
+
+        if (addr->port() == 0) {
             return std::unexpected(ErrorCode::InvalidAddress);
         }
-    
-        return ReceivedPacket{
-            .data = reinterpret_cast<const uint8_t*>(buf),
+
+        return CoalescedPacket{
+            .data = coalesced_buf_.get(),
             .length = static_cast<size_t>(received),
-            .addr = std::move(*addr)
+            .segmentSize = static_cast<size_t>(received),
+            .addr = *addr
         };
     }
-    
+
+    std::expected<SocketMetrics, ErrorCode> metrics() const override {
+        // Instrumentation currently covers the Unix backends only
+        return std::unexpected(ErrorCode::NotSupported);
+    }
+
+    std::expected<SocketConfig, ErrorCode> effectiveConfig() const override {
+        if (sock_ == INVALID_SOCKET) {
+            return std::unexpected(ErrorCode::InvalidSocket);
+        }
+
+        SocketConfig config;
+        config.max_datagram_size = max_datagram_;
+        int value = 0;
+        if (getIntOption(SOL_SOCKET, SO_RCVBUF, value)) {
+            config.recv_buffer_size = static_cast<size_t>(value);
+        }
+        if (getIntOption(SOL_SOCKET, SO_SNDBUF, value)) {
+            config.send_buffer_size = static_cast<size_t>(value);
+        }
+        return config;
+    }
+
+    std::expected<Endpoint, ErrorCode> localEndpoint() const override {
+        if (sock_ == INVALID_SOCKET) {
+            return std::unexpected(ErrorCode::InvalidSocket);
+        }
+
+        sockaddr_storage local{};
+        int localLen = sizeof(local);
+        if (getsockname(sock_, reinterpret_cast<sockaddr*>(&local), &localLen) == SOCKET_ERROR) {
+            return std::unexpected(ErrorCode::InvalidSocket);
+        }
+        return decodeAddr(reinterpret_cast<const sockaddr*>(&local));
+    }
+
     std::expected<int, ErrorCode> getHandle() const override {
         if (sock_ == INVALID_SOCKET) {
             return std::unexpected(ErrorCode::InvalidSocket);
@@ -171,34 +409,137 @@ public:
     }
 
 private:
-    SOCKET sock_;
+    bool getIntOption(int level, int opt, int& value) const {
+        int len = sizeof(value);
+        return getsockopt(sock_, level, opt, reinterpret_cast<char*>(&value), &len) == 0;
+    }
 
-    static std::expected<Addr, ErrorCode> decodeAddr(const sockaddr* addr) {
-        char ip[INET6_ADDRSTRLEN];
-        uint16_t port = 0;
+    std::expected<ReceivedPacket, ErrorCode> receiveInto(uint8_t* buf, size_t capacity) {
+        sockaddr_storage src{};
+        int srclen = sizeof(src);
     
-        if (addr->sa_family == AF_INET) {
-            auto* a = reinterpret_cast<const sockaddr_in*>(addr);
-            if (!inet_ntop(AF_INET, &a->sin_addr, ip, sizeof(ip))) {
-                return std::unexpected(ErrorCode::InvalidAddress);
-            }
-            port = ntohs(a->sin_port);
-        } else if (addr->sa_family == AF_INET6) {
-            auto* a = reinterpret_cast<const sockaddr_in6*>(addr);
-            if (!inet_ntop(AF_INET6, &a->sin6_addr, ip, sizeof(ip))) {
-                return std::unexpected(ErrorCode::InvalidAddress);
+        int received = ::recvfrom(
+            sock_,
+            reinterpret_cast<char*>(buf),
+            static_cast<int>(capacity),
+            0,
+            reinterpret_cast<sockaddr*>(&src),
+            &srclen
+        );
+    
+        bool truncated = false;
+        if (received == SOCKET_ERROR) {
+            int err = WSAGetLastError();
+            if (err != WSAEMSGSIZE) {
+                return mapWSARecvError(err);
             }
-            port = ntohs(a->sin6_port);
-        } else {
-            return std::unexpected(ErrorCode::UnsupportedAddressFamily);
+            truncated = true;
+            received = static_cast<int>(capacity);
+        }
+    
+        auto addr = decodeAddr(reinterpret_cast<sockaddr*>(&src));
+        if (!addr) {
+            return std::unexpected(addr.error());
+        }
+    
+        if (addr->port() == 0) {
+            return std::unexpected(ErrorCode::InvalidAddress);
         }
     
-        return Addr{ip, port};
+        return ReceivedPacket{
+            .data = reinterpret_cast<const uint8_t*>(buf),
+            .length = static_cast<size_t>(received),
+            .addr = *addr,
+            .truncated = truncated,
+            .datagram_length = truncated ? 0 : static_cast<size_t>(received)
+        };
+    }
+
+    SOCKET sock_;
+    size_t max_datagram_; // SocketConfig::max_datagram_size: receive size for recvFrom()/recvBatch()
+    std::unique_ptr<uint8_t[]> coalesced_buf_;
+
+    static std::expected<Endpoint, ErrorCode> decodeAddr(const sockaddr* addr) {
+        Endpoint ep = Endpoint::FromSockaddr(addr);
+        if (!ep.isSpecified()) {
+            return std::unexpected(ErrorCode::UnsupportedAddressFamily);
+        }
+        return ep;
     }
     
 };
 
+// Library defaults used when SocketConfig leaves a buffer size at 0
+constexpr int kDefaultSendBufferSize = 4 * 1024 * 1024;
+constexpr int kDefaultRecvBufferSize = 1 * 1024 * 1024;
+
+static std::expected<void, ErrorCode> setIntOption(SOCKET sock, int level, int opt, int value) {
+    if (setsockopt(sock, level, opt, reinterpret_cast<const char*>(&value), sizeof(value)) != 0) {
+        return std::unexpected(ErrorCode::SocketConfigFailed);
+    }
+    return {};
+}
+
+// Applies every requested SocketConfig option to a fresh socket, before bind()/connect()
+static std::expected<void, ErrorCode> applySocketOptions(SOCKET sock, int family, const SocketConfig& config) {
+    if (config.dscp > 63 || config.max_datagram_size == 0 || config.max_datagram_size > kMaxDatagramSize) {
+        return std::unexpected(ErrorCode::InvalidArgument);
+    }
+
+    // No Winsock equivalent for these
+    if (config.busy_poll_us > 0 || config.priority >= 0 || config.incoming_cpu >= 0 || config.reuse_port ||
+        config.rx_timestamps || config.rx_drop_counter) {
+        return std::unexpected(ErrorCode::NotSupported);
+    }
+
+    const int sendSize = config.send_buffer_size > 0 ? static_cast<int>(std::min<size_t>(config.send_buffer_size, INT_MAX)) : kDefaultSendBufferSize;
+    const int recvSize = config.recv_buffer_size > 0 ? static_cast<int>(std::min<size_t>(config.recv_buffer_size, INT_MAX)) : kDefaultRecvBufferSize;
+    if (auto ok = setIntOption(sock, SOL_SOCKET, SO_SNDBUF, sendSize); !ok) {
+        return ok;
+    }
+    if (auto ok = setIntOption(sock, SOL_SOCKET, SO_RCVBUF, recvSize); !ok) {
+        return ok;
+    }
+
+    if (config.mtu_discovery != MtuDiscovery::Default) {
+#if defined(IP_MTU_DISCOVER)
+        int mode = IP_PMTUDISC_NOT_SET;
+        switch (config.mtu_discovery) {
+        case MtuDiscovery::Dont: mode = IP_PMTUDISC_DONT; break;
+        case MtuDiscovery::Do: mode = IP_PMTUDISC_DO; break;
+        case MtuDiscovery::Probe: mode = IP_PMTUDISC_PROBE; break;
+        case MtuDiscovery::Default: break;
+        }
+        const bool v6 = family == AF_INET6;
+        if (auto ok = setIntOption(sock, v6 ? IPPROTO_IPV6 : IPPROTO_IP, v6 ? IPV6_MTU_DISCOVER : IP_MTU_DISCOVER, mode); !ok) {
+            return ok;
+        }
+#else
+        return std::unexpected(ErrorCode::NotSupported);
+#endif
+    }
+
+    if (config.dscp >= 0) {
+        // Windows only honours this with the qWAVE API or a matching group policy; the call itself succeeds
+        const int tos = config.dscp << 2;
+        auto ok = (family == AF_INET6) ? setIntOption(sock, IPPROTO_IPV6, IPV6_TCLASS, tos) : setIntOption(sock, IPPROTO_IP, IP_TOS, tos);
+        if (!ok) {
+            return ok;
+        }
+    }
+
+    return {};
+}
+
 std::expected<std::unique_ptr<Socket>, ErrorCode> Listen(const Addr& bindAddr) {
+    return Listen(bindAddr, SocketConfig{});
+}
+
+std::expected<std::unique_ptr<Socket>, ErrorCode> Listen(const Addr& bindAddr, const SocketConfig& config) {
+    if (config.backend != SocketBackend::Syscall) {
+        return std::unexpected(ErrorCode::NotSupported);
+    }
+
     if (auto err = initWSA(); !err) {
         return std::unexpected(err.error());
     }
@@ -234,6 +575,11 @@ std::expected<std::unique_ptr<Socket>, ErrorCode> Listen(const Addr& bindAddr) {
         return std::unexpected(ErrorCode::SocketConfigFailed);
     }
 
+    if (auto applied = applySocketOptions(sock, family, config); !applied) {
+        closesocket(sock);
+        return std::unexpected(applied.error());
+    }
+
     int result = bind(
         sock,
         reinterpret_cast<const sockaddr*>(addrPtr),
@@ -245,10 +591,18 @@ std::expected<std::unique_ptr<Socket>, ErrorCode> Listen(const Addr& bindAddr) {
         return std::unexpected(ErrorCode::BindFailed);
     }
 
-    return std::make_unique<SocketWindows>(sock);
+    return std::make_unique<SocketWindows>(sock, config.max_datagram_size);
 }
 
 std::expected<std::unique_ptr<Socket>, ErrorCode> Dial(const Addr& remoteAddr) {
+    return Dial(remoteAddr, SocketConfig{});
+}
+
+std::expected<std::unique_ptr<Socket>, ErrorCode> Dial(const Addr& remoteAddr, const SocketConfig& config) {
+    if (config.backend != SocketBackend::Syscall) {
+        return std::unexpected(ErrorCode::NotSupported);
+    }
+
     if (auto err = initWSA(); !err) {
         return std::unexpected(err.error());
     }
@@ -285,13 +639,63 @@ std::expected<std::unique_ptr<Socket>, ErrorCode> Dial(const Addr& remoteAddr) {
         return std::unexpected(ErrorCode::SocketConfigFailed);
     }
 
+    if (auto applied = applySocketOptions(sock, family, config); !applied) {
+        closesocket(sock);
+        return std::unexpected(applied.error());
+    }
+
     if (connect(sock, reinterpret_cast<sockaddr*>(&remoteSock), remoteLen) == SOCKET_ERROR) {
         closesocket(sock);
         return std::unexpected(ErrorCode::ConnectFailed);
     }
 
-    return std::make_unique<SocketWindows>(sock);
+    return std::make_unique<SocketWindows>(sock, config.max_datagram_size);
+}
+
+
+std::expected<std::vector<std::unique_ptr<Socket>>, ErrorCode> ListenGroup(const Addr& bindAddr, const ListenGroupConfig& config) {
+    const size_t count = (config.socket_count == 0) ? std::max(1u, std::thread::hardware_concurrency()) : config.socket_count;
+
+    // Winsock has no load-balancing equivalent of SO_REUSEPORT; SO_REUSEADDR would deliver everything to one socket
+    if (count > 1 || config.steering != ListenSteering::FlowHash) {
+        return std::unexpected(ErrorCode::NotSupported);
+    }
+
+    auto sock = Listen(bindAddr, config.socket);
+    if (!sock) {
+        return std::unexpected(sock.error());
+    }
+
+    std::vector<std::unique_ptr<Socket>> group;
+    group.push_back(std::move(*sock));
+    return group;
 }
 
+std::expected<void, ErrorCode> PinCurrentThread(size_t cpu) {
+    if (cpu >= sizeof(DWORD_PTR) * 8) {
+        return std::unexpected(ErrorCode::InvalidArgument);
+    }
+
+    if (SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << cpu) == 0) {
+        return std::unexpected(ErrorCode::InvalidArgument);
+    }
+    return {};
+}
+
+std::expected<PeerSession, ErrorCode> PeerSession::Open(Socket& listener, const Endpoint& peer, const PeerSessionConfig& config) {
+    auto local = listener.localEndpoint();
+    if (!local) {
+        return std::unexpected(local.error());
+    }
+    if (!peer.isSpecified() || peer.port() == 0 || peer.family() != local->family()) {
+        return std::unexpected(ErrorCode::InvalidAddress);
+    }
+
+    // Winsock has no SO_REUSEPORT group that would route the peer's datagrams to a connected socket
+    if (config.connected) {
+        return std::unexpected(ErrorCode::NotSupported);
+    }
+    return PeerSession(listener, peer, nullptr);
+}
 
 } // namespace pulse::net::udp
\ No newline at end of file
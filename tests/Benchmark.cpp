@@ -0,0 +1,429 @@
+#include <pulse/net/udp/udp.h>
+#include <pulse/net/udp/poller.h>
+#include <pulse/net/udp/listen_group.h>
+#include <pulse/net/udp/peer_session.h>
+#include <pulse/net/udp/metrics.h>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cstring>
+
+// Loopback throughput and latency benchmark. Every result is one JSON object per line on stdout,
+// so runs can be diffed or fed to a dashboard to track regressions across versions.
+//
+//   pulsenet_udp_bench [--duration-ms N] [--iterations N] [--sizes 64,512,1200]
+
+using namespace pulse::net::udp;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr uint16_t kBasePort = 9100;
+
+struct Options {
+    uint64_t duration_ms = 1000;
+    size_t iterations = 20000;
+    std::vector<size_t> sizes = {64, 512, 1200, 8192};
+};
+
+enum class SendMode {
+    Single,   // one send() per datagram
+    Batch,    // sendBatch() of kMaxSendBatch datagrams
+    Segmented // sendSegmented(), i.e. UDP GSO where available
+};
+
+const char* toString(SendMode mode) {
+    switch (mode) {
+    case SendMode::Single: return "single";
+    case SendMode::Batch: return "batch";
+    case SendMode::Segmented: return "gso";
+    }
+    return "unknown";
+}
+
+const char* toString(SocketBackend backend) {
+    return backend == SocketBackend::IoUring ? "io_uring" : "syscall";
+}
+
+struct Tally {
+    uint64_t packets = 0;
+    uint64_t bytes = 0;
+    uint64_t truncated = 0; // datagrams cut to the receive size; nonzero means the socket's max_datagram_size is too small
+};
+
+uint64_t elapsedNs(Clock::time_point from, Clock::time_point to) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count());
+}
+
+// Drains `socket` until `running` clears, parking on a poller when the queue is empty
+Tally drain(Socket& socket, const std::atomic<bool>& running) {
+    Tally tally;
+    auto poller = Poller::Create();
+    if (!poller || !(*poller)->add(socket, 0)) {
+        return tally;
+    }
+
+    ReceivedPacket batch[kMaxRecvBatch];
+    while (running.load(std::memory_order_relaxed)) {
+        auto n = socket.recvBatch(batch);
+        if (!n) {
+            if (n.error() == ErrorCode::WouldBlock) {
+                (*poller)->wait(1'000'000);
+            }
+            continue;
+        }
+        tally.packets += *n;
+        for (size_t i = 0; i < *n; ++i) {
+            // datagram_length is what was sent; it is 0 for a truncated datagram where the platform cannot tell
+            tally.bytes += std::max(batch[i].length, batch[i].datagram_length);
+            tally.truncated += batch[i].truncated ? 1 : 0;
+        }
+    }
+    return tally;
+}
+
+// Sends `payload`-byte datagrams through a connected socket as fast as `mode` allows until `deadline`
+Tally blast(Socket& socket, SendMode mode, size_t payload, Clock::time_point deadline) {
+    const size_t segments = std::max<size_t>(1, std::min(kMaxGsoSegments, kMaxGsoBytes / payload));
+    std::vector<uint8_t> data(payload * std::max(segments, kMaxSendBatch), 0x5A);
+
+    std::vector<OutgoingPacket> batch(kMaxSendBatch);
+    for (size_t i = 0; i < batch.size(); ++i) {
+        batch[i] = OutgoingPacket{.addr = Endpoint{}, .data = data.data() + i * payload, .length = payload};
+    }
+
+    Tally tally;
+    while (Clock::now() < deadline) {
+        size_t sent = 0;
+        switch (mode) {
+        case SendMode::Single:
+            sent = socket.send(data.data(), payload) ? 1 : 0;
+            break;
+        case SendMode::Batch:
+            if (auto n = socket.sendBatch(batch)) {
+                sent = *n;
+            }
+            break;
+        case SendMode::Segmented:
+            if (auto n = socket.sendSegmented(Endpoint{}, data.data(), payload * segments, payload)) {
+                sent = *n;
+            }
+            break;
+        }
+
+        if (sent == 0) {
+            std::this_thread::yield(); // socket buffer full; let the receiver catch up
+            continue;
+        }
+        tally.packets += sent;
+        tally.bytes += sent * payload;
+    }
+    return tally;
+}
+
+void emitThroughput(const char* scenario, const char* mode, const char* backend, size_t payload, size_t sockets,
+                    const Tally& sent, const Tally& received, uint64_t durationNs) {
+    const double seconds = static_cast<double>(durationNs) / 1e9;
+    const double loss = sent.packets ? 1.0 - static_cast<double>(received.packets) / static_cast<double>(sent.packets) : 0.0;
+    std::cout << "{\"bench\":\"" << scenario << "\",\"mode\":\"" << mode << "\",\"backend\":\"" << backend
+              << "\",\"payload\":" << payload << ",\"sockets\":" << sockets
+              << ",\"sent_pps\":" << static_cast<uint64_t>(static_cast<double>(sent.packets) / seconds)
+              << ",\"recv_pps\":" << static_cast<uint64_t>(static_cast<double>(received.packets) / seconds)
+              << ",\"recv_bps\":" << static_cast<uint64_t>(static_cast<double>(received.bytes) * 8 / seconds)
+              << ",\"loss\":" << std::max(0.0, loss) << ",\"truncated\":" << received.truncated << "}" << std::endl;
+}
+
+int benchThroughput(const Options& options, SendMode mode, SocketBackend backend, size_t payload, uint16_t port) {
+    if (mode == SendMode::Segmented && payload > kMaxGsoBytes) {
+        return 0;
+    }
+
+    const SocketConfig config{.backend = backend, .recv_buffer_size = 8 * 1024 * 1024, .send_buffer_size = 4 * 1024 * 1024,
+                              .max_datagram_size = payload};
+    Addr addr("127.0.0.1", port);
+    auto server = Listen(addr, config);
+    if (!server && server.error() == ErrorCode::NotSupported) {
+        return 0; // backend unavailable on this kernel
+    }
+    auto client = Dial(addr, config);
+    if (!server || !client) {
+        std::cerr << "throughput: failed to open sockets on port " << port << std::endl;
+        return 1;
+    }
+
+    std::atomic<bool> running{true};
+    Tally received;
+    std::thread receiver([&] { received = drain(**server, running); });
+
+    const auto start = Clock::now();
+    const Tally sent = blast(**client, mode, payload, start + std::chrono::milliseconds(options.duration_ms));
+    const uint64_t durationNs = elapsedNs(start, Clock::now());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50)); // let the receiver drain what is queued
+    running.store(false, std::memory_order_relaxed);
+    receiver.join();
+
+    emitThroughput("throughput", toString(mode), toString(backend), payload, 1, sent, received, durationNs);
+    return 0;
+}
+
+// One ListenGroup member per hardware thread, each drained by its own thread, fed by as many senders
+int benchMultiSocket(const Options& options, size_t payload, uint16_t port) {
+    const size_t workers = std::max(2u, std::thread::hardware_concurrency());
+    ListenGroupConfig groupConfig{.socket_count = workers, .socket = {}};
+    groupConfig.socket.recv_buffer_size = 8 * 1024 * 1024;
+    groupConfig.socket.max_datagram_size = payload;
+
+    Addr addr("127.0.0.1", port);
+    auto group = ListenGroup(addr, groupConfig);
+    if (!group) {
+        if (group.error() == ErrorCode::NotSupported) {
+            return 0;
+        }
+        std::cerr << "multi_socket: ListenGroup failed: " << ErrorToString(group.error()) << std::endl;
+        return 1;
+    }
+
+    std::vector<std::unique_ptr<Socket>> clients;
+    for (size_t i = 0; i < workers; ++i) {
+        auto client = Dial(addr);
+        if (!client) {
+            std::cerr << "multi_socket: Dial failed" << std::endl;
+            return 1;
+        }
+        clients.push_back(std::move(*client));
+    }
+
+    std::atomic<bool> running{true};
+    std::vector<Tally> received(workers);
+    std::vector<Tally> sent(workers);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < workers; ++i) {
+        threads.emplace_back([&, i] { received[i] = drain(*(*group)[i], running); });
+    }
+
+    const auto start = Clock::now();
+    const auto deadline = start + std::chrono::milliseconds(options.duration_ms);
+    std::vector<std::thread> senders;
+    for (size_t i = 0; i < workers; ++i) {
+        senders.emplace_back([&, i] { sent[i] = blast(*clients[i], SendMode::Batch, payload, deadline); });
+    }
+    for (auto& t : senders) {
+        t.join();
+    }
+    const uint64_t durationNs = elapsedNs(start, Clock::now());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    running.store(false, std::memory_order_relaxed);
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    Tally totalSent;
+    Tally totalReceived;
+    for (size_t i = 0; i < workers; ++i) {
+        totalSent.packets += sent[i].packets;
+        totalSent.bytes += sent[i].bytes;
+        totalReceived.packets += received[i].packets;
+        totalReceived.bytes += received[i].bytes;
+        totalReceived.truncated += received[i].truncated;
+    }
+
+    emitThroughput("multi_socket", "batch", "syscall", payload, workers, totalSent, totalReceived, durationNs);
+    return 0;
+}
+
+// Server-to-peer sends, through the listener with a pre-encoded destination or through a connected PeerSession
+int benchPeerSend(const Options& options, bool connected, size_t payload, uint16_t port) {
+    Addr addr("127.0.0.1", port);
+    auto listener = Listen(addr, SocketConfig{.reuse_port = true});
+    if (!listener && listener.error() == ErrorCode::NotSupported) {
+        return 0;
+    }
+    auto client = Dial(addr, SocketConfig{.recv_buffer_size = 8 * 1024 * 1024, .max_datagram_size = payload});
+    if (!listener || !client) {
+        std::cerr << "peer_send: failed to open sockets on port " << port << std::endl;
+        return 1;
+    }
+    auto peer = (*client)->localEndpoint();
+    if (!peer) {
+        return 1;
+    }
+    auto session = PeerSession::Open(**listener, *peer, PeerSessionConfig{.connected = connected, .socket = {}});
+    if (!session) {
+        if (session.error() == ErrorCode::NotSupported) {
+            return 0;
+        }
+        std::cerr << "peer_send: PeerSession::Open failed: " << ErrorToString(session.error()) << std::endl;
+        return 1;
+    }
+
+    std::atomic<bool> running{true};
+    Tally received;
+    std::thread receiver([&] { received = drain(**client, running); });
+
+    std::vector<uint8_t> data(payload, 0x3C);
+    Tally sent;
+    const auto start = Clock::now();
+    const auto deadline = start + std::chrono::milliseconds(options.duration_ms);
+    while (Clock::now() < deadline) {
+        if (!session->send(data.data(), data.size())) {
+            std::this_thread::yield();
+            continue;
+        }
+        sent.packets++;
+        sent.bytes += payload;
+    }
+    const uint64_t durationNs = elapsedNs(start, Clock::now());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    running.store(false, std::memory_order_relaxed);
+    receiver.join();
+
+    emitThroughput("peer_send", connected ? "connected" : "sendto", "syscall", payload, 1, sent, received, durationNs);
+    return 0;
+}
+
+// Ping-pong round trips against an echo thread; the client spins on recvFrom() so wakeup latency is not measured
+int benchLatency(const Options& options, SocketBackend backend, size_t payload, uint16_t port) {
+    const SocketConfig config{.backend = backend, .max_datagram_size = payload};
+    Addr addr("127.0.0.1", port);
+    auto server = Listen(addr, config);
+    if (!server && server.error() == ErrorCode::NotSupported) {
+        return 0;
+    }
+    auto client = Dial(addr, config);
+    if (!server || !client) {
+        std::cerr << "latency: failed to open sockets on port " << port << std::endl;
+        return 1;
+    }
+
+    std::atomic<bool> running{true};
+    std::thread echo([&] {
+        auto poller = Poller::Create();
+        if (!poller || !(*poller)->add(**server, 0)) {
+            return;
+        }
+        while (running.load(std::memory_order_relaxed)) {
+            auto packet = (*server)->recvFrom();
+            if (!packet) {
+                (*poller)->wait(1'000'000);
+                continue;
+            }
+            (*server)->sendTo(packet->addr, packet->data, packet->length);
+        }
+    });
+
+    std::vector<uint8_t> data(payload, 0xA5);
+    LatencyHistogram histogram{};
+    size_t lost = 0;
+    for (size_t i = 0; i < options.iterations; ++i) {
+        const auto sentAt = Clock::now();
+        if (!(*client)->send(data.data(), data.size())) {
+            lost++;
+            continue;
+        }
+
+        const auto deadline = sentAt + std::chrono::milliseconds(100);
+        bool answered = false;
+        while (Clock::now() < deadline) {
+            if ((*client)->recvFrom()) {
+                answered = true;
+                break;
+            }
+            std::this_thread::yield();
+        }
+        if (!answered) {
+            lost++;
+            continue;
+        }
+
+        const uint64_t rtt = elapsedNs(sentAt, Clock::now());
+        histogram.counts[LatencyBucketIndex(rtt)]++;
+        histogram.samples++;
+        histogram.sum_ns += rtt;
+        histogram.max_ns = std::max(histogram.max_ns, rtt);
+    }
+
+    running.store(false, std::memory_order_relaxed);
+    echo.join();
+
+    std::cout << "{\"bench\":\"rtt\",\"backend\":\"" << toString(backend) << "\",\"payload\":" << payload
+              << ",\"samples\":" << histogram.samples << ",\"lost\":" << lost
+              << ",\"mean_ns\":" << (histogram.samples ? histogram.sum_ns / histogram.samples : 0)
+              << ",\"p50_ns\":" << histogram.percentile(0.50)
+              << ",\"p99_ns\":" << histogram.percentile(0.99)
+              << ",\"p999_ns\":" << histogram.percentile(0.999)
+              << ",\"max_ns\":" << histogram.max_ns << "}" << std::endl;
+    return 0;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (arg == "--duration-ms") {
+            options.duration_ms = std::stoull(value);
+        } else if (arg == "--iterations") {
+            options.iterations = std::stoull(value);
+        } else if (arg == "--sizes") {
+            options.sizes.clear();
+            std::stringstream list(value);
+            std::string item;
+            while (std::getline(list, item, ',')) {
+                options.sizes.push_back(std::stoull(item));
+            }
+        } else {
+            return false;
+        }
+    }
+    return !options.sizes.empty();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: pulsenet_udp_bench [--duration-ms N] [--iterations N] [--sizes 64,512,1200]" << std::endl;
+        return 1;
+    }
+
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    std::cout << "{\"bench\":\"meta\",\"unix_time\":" << std::chrono::duration_cast<std::chrono::seconds>(now).count()
+              << ",\"hardware_threads\":" << std::thread::hardware_concurrency()
+              << ",\"duration_ms\":" << options.duration_ms << ",\"iterations\":" << options.iterations << "}" << std::endl;
+
+    uint16_t port = kBasePort;
+    for (size_t payload : options.sizes) {
+        for (SendMode mode : {SendMode::Single, SendMode::Batch, SendMode::Segmented}) {
+            if (benchThroughput(options, mode, SocketBackend::Syscall, payload, port++) != 0) {
+                return 1;
+            }
+        }
+        if (benchThroughput(options, SendMode::Batch, SocketBackend::IoUring, payload, port++) != 0 ||
+            benchMultiSocket(options, payload, port++) != 0 ||
+            benchPeerSend(options, false, payload, port++) != 0 ||
+            benchPeerSend(options, true, payload, port++) != 0) {
+            return 1;
+        }
+    }
+
+    for (size_t payload : options.sizes) {
+        for (SocketBackend backend : {SocketBackend::Syscall, SocketBackend::IoUring}) {
+            if (benchLatency(options, backend, payload, port++) != 0) {
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
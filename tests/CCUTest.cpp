@@ -1,142 +1,556 @@
 #include <pulse/net/udp/udp.h>
+#include <pulse/net/udp/listen_group.h>
+#include <pulse/net/udp/metrics.h>
+#include <pulse/net/udp/packet_ring.h>
+#include <pulse/net/udp/reactor.h>
+#include <pulse/net/udp/receive_driver.h>
+#include <pulse/net/udp/session_table.h>
 #include <iostream>
-#include <unordered_map>
+#include <vector>
 #include <chrono>
 #include <thread>
+#include <algorithm>
 #include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <latch>
+#include <optional>
+#include <string>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
 
 using namespace pulse::net::udp;
 
-int handleServer() {
-    Addr serverAddr("127.0.0.1", 9000);
-    auto sockResult = Listen(serverAddr);
-    if (!sockResult) {
-        std::cerr << "Failed to bind server: " << static_cast<int>(sockResult.error()) << std::endl;
-        return 1;
+constexpr size_t kMaxSessions = 65536;
+constexpr uint64_t kSessionIdleNs = 30'000'000'000; // clients silent this long give their slot back
+constexpr uint64_t kSweepIntervalNs = 1'000'000'000;
+
+uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// ---- Echo server ----
+// One worker per ListenGroup member: each owns its socket, receive driver and session table, so the hot path
+// shares nothing between threads but a few relaxed counters. Datagrams are read in batches and echoed with one
+// sendBatch() per batch straight out of the receive buffers; nothing is allocated once a worker is running.
+
+struct ServerConfig {
+    std::string host = "127.0.0.1";
+    uint16_t port = 9000;
+    uint32_t threads = 1;    // 0 runs one worker per hardware thread
+    bool pin = false;        // pin worker i to CPU i and ask the kernel to steer that CPU's datagrams to its socket
+    uint32_t duration_s = 0; // 0 serves until killed
+};
+
+// Written by one worker and read by the reporter; a cache line each so workers do not contend on it
+struct alignas(kCacheLineSize) ServerCounters {
+    std::atomic<uint64_t> received{0};
+    std::atomic<uint64_t> echoed{0};
+    std::atomic<uint64_t> dropped{0}; // echoes abandoned because the send buffer stayed full
+    std::atomic<uint64_t> batches{0};
+    std::atomic<uint64_t> sessions{0};
+};
+
+constexpr size_t kEchoSendRetries = 4; // sendBatch() attempts per batch before the rest of it is dropped
+
+void runServerWorker(Socket& socket, size_t worker, const ServerConfig& config, const std::atomic<bool>& stop, ServerCounters& counters) {
+    if (config.pin) {
+        if (auto pinned = PinCurrentThread(worker); !pinned) {
+            std::cerr << "Failed to pin worker " << worker << ": " << ErrorToString(pinned.error()) << std::endl;
+        }
+    }
+
+    // Spin briefly between datagrams while clients are busy, park on readiness once they go quiet
+    auto driverResult = ReceiveDriver::Create(socket);
+    if (!driverResult) {
+        std::cerr << "Failed to set up the receive driver: " << ErrorToString(driverResult.error()) << std::endl;
+        return;
     }
+    auto& driver = *driverResult;
 
-    auto& server = *sockResult;
+    auto sessionsResult = SessionTable::Create(kMaxSessions, kSessionIdleNs);
+    if (!sessionsResult) {
+        std::cerr << "Failed to create the session table" << std::endl;
+        return;
+    }
+    auto& sessions = *sessionsResult;
+    SessionHandle evicted[64];
+    uint64_t nextSweepNs = nowNs() + kSweepIntervalNs;
 
-    std::unordered_map<std::string, int> clientDatagramCount;
+    ReceivedPacket packets[kMaxRecvBatch];
+    OutgoingPacket echoes[kMaxRecvBatch];
 
-    while (true) {
-        auto packet = server->recvFrom();
-        if (!packet.has_value()) {
-            if (packet.error() == ErrorCode::WouldBlock) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(1));
-                continue;
+    while (!stop.load(std::memory_order_relaxed)) {
+        auto received = driver.nextBatch(packets, kSweepIntervalNs);
+        const uint64_t now = nowNs();
+        if (now >= nextSweepNs) {
+            // Close sessions that went quiet
+            while (sessions.evictIdle(now, evicted) == std::size(evicted)) {
+            }
+            counters.sessions.store(sessions.size(), std::memory_order_relaxed);
+            nextSweepNs = now + kSweepIntervalNs;
+        }
+        if (!received.has_value()) {
+            if (received.error() != ErrorCode::Timeout) {
+                std::cerr << "recvBatch failed: " << ErrorToString(received.error()) << std::endl;
             }
-            std::cerr << "recvFrom failed: " << static_cast<int>(packet.error()) << std::endl;
             continue;
         }
 
-        const auto& [data, length, addr] = *packet;
-        std::string clientKey = addr.ip + ":" + std::to_string(addr.port);
-        clientDatagramCount[clientKey]++;
+        size_t echoCount = 0;
+        for (size_t i = 0; i < *received; ++i) {
+            const auto& [data, length, addr, rxTimestampNs, drops, truncated, datagramLength] = packets[i];
+            if (!sessions.touch(addr, now)) {
+                continue; // table full: refuse new clients rather than evict active ones
+            }
+            echoes[echoCount++] = OutgoingPacket{.addr = addr, .data = data, .length = length};
+        }
+
+        // The payloads live in the socket's receive storage, so the whole batch has to go out before the next receive
+        size_t sent = 0;
+        for (size_t attempt = 0; sent < echoCount && attempt < kEchoSendRetries; ++attempt) {
+            auto accepted = socket.sendBatch(std::span<const OutgoingPacket>(echoes + sent, echoCount - sent));
+            if (accepted) {
+                sent += *accepted;
+            } else if (accepted.error() != ErrorCode::WouldBlock) {
+                std::cerr << "sendBatch failed: " << ErrorToString(accepted.error()) << std::endl;
+                sent++; // skip the datagram the kernel refused
+            }
+        }
+
+        counters.received.fetch_add(*received, std::memory_order_relaxed);
+        counters.echoed.fetch_add(sent, std::memory_order_relaxed);
+        counters.dropped.fetch_add(echoCount - sent, std::memory_order_relaxed);
+        counters.batches.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+int handleServer(const ServerConfig& config) {
+    const Addr serverAddr(config.host, config.port);
+    auto groupResult = ListenGroup(serverAddr, ListenGroupConfig{
+        .socket_count = config.threads,
+        .pin_to_cpu = config.pin,
+        // Room for a full burst from every client so the kernel does not drop while we are busy echoing
+        .socket = SocketConfig{.recv_buffer_size = 8 * 1024 * 1024, .send_buffer_size = 4 * 1024 * 1024}
+    });
+    if (!groupResult) {
+        std::cerr << "Failed to bind server: " << ErrorToString(groupResult.error()) << std::endl;
+        return 1;
+    }
+    auto& group = *groupResult;
+
+    std::cout << "Serving on " << config.host << ":" << config.port << " with " << group.size() << " workers"
+              << (config.pin ? ", pinned to CPUs" : "") << std::endl;
+
+    std::atomic<bool> stop{false};
+    std::vector<ServerCounters> counters(group.size());
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < group.size(); ++i) {
+        workers.emplace_back(runServerWorker, std::ref(*group[i]), i, std::cref(config), std::cref(stop), std::ref(counters[i]));
+    }
+
+    // Report throughput once a second until the run is over
+    uint64_t lastReceived = 0;
+    uint64_t lastEchoed = 0;
+    const uint64_t startNs = nowNs();
+    for (uint32_t second = 1; config.duration_s == 0 || second <= config.duration_s; ++second) {
+        std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(startNs + second * kSweepIntervalNs)));
 
-        auto result = server->sendTo(addr, data, length);
-        if (!result) {
-            std::cerr << "sendTo failed: " << static_cast<int>(result.error()) << std::endl;
+        uint64_t received = 0, echoed = 0, dropped = 0, batches = 0, active = 0;
+        for (const auto& worker : counters) {
+            received += worker.received.load(std::memory_order_relaxed);
+            echoed += worker.echoed.load(std::memory_order_relaxed);
+            dropped += worker.dropped.load(std::memory_order_relaxed);
+            batches += worker.batches.load(std::memory_order_relaxed);
+            active += worker.sessions.load(std::memory_order_relaxed);
         }
+        if (received != lastReceived) {
+            std::cout << "rx " << received - lastReceived << "/s, echoed " << echoed - lastEchoed << "/s, dropped " << dropped
+                      << " total, " << (batches ? static_cast<double>(received) / static_cast<double>(batches) : 0.0)
+                      << " datagrams/batch, " << active << " sessions" << std::endl;
+        }
+        lastReceived = received;
+        lastEchoed = echoed;
     }
 
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& worker : workers) {
+        worker.join();
+    }
     return 0;
 }
 
-void sendDatagrams(const std::string& serverIp, uint16_t serverPort,
-                   std::atomic<uint64_t>* datagramCount,
-                   std::atomic<uint64_t>* datagramTimeoutCount,
-                   std::atomic<bool>* stopFlag) {
-    Addr serverAddr(serverIp, serverPort);
-    auto sockResult = Dial(serverAddr);
-    if (!sockResult) {
-        std::cerr << "Failed to dial server: " << static_cast<int>(sockResult.error()) << std::endl;
-        return;
+// ---- Load generator ----
+// Every worker thread runs one Reactor that multiplexes its share of the client sockets as coroutines,
+// so thousands of simulated clients cost a socket and a coroutine frame each rather than a thread each.
+
+enum class LoadMode {
+    Closed, // one request in flight per client: send on the tick, wait for the echo until the next tick
+    Open    // send on every tick regardless of replies; a separate coroutine collects the echoes
+};
+
+struct LoadConfig {
+    std::string host = "127.0.0.1";
+    uint16_t port = 9000;
+    uint32_t clients = 10;
+    uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+    uint32_t tick_hz = 24;
+    uint32_t duration_s = 10;
+    size_t payload_min = 16; // each datagram's size is drawn uniformly from [payload_min, payload_max]
+    size_t payload_max = 16;
+    LoadMode mode = LoadMode::Closed;
+};
+
+// Header at the front of every request; the server echoes it back untouched
+struct ProbeHeader {
+    uint32_t client;
+    uint32_t seq;
+    uint64_t sent_ns;
+};
+
+constexpr size_t kMaxPayload = 1400;
+constexpr uint64_t kOpenLoopDrainNs = 500'000'000; // how long open-loop receivers wait for stragglers after the run
+
+struct LoadStats {
+    uint64_t clients = 0;
+    uint64_t sent = 0;
+    uint64_t received = 0;
+    uint64_t timeouts = 0;    // closed loop: no echo before the next tick
+    uint64_t stale = 0;       // closed loop: echoes of requests that had already timed out
+    uint64_t send_errors = 0;
+    uint64_t recv_errors = 0;
+    LatencyHistogram rtt{};
+
+    void record(uint64_t rttNs) {
+        received++;
+        rtt.counts[LatencyBucketIndex(rttNs)]++;
+        rtt.samples++;
+        rtt.sum_ns += rttNs;
+        rtt.max_ns = std::max(rtt.max_ns, rttNs);
     }
 
-    auto& client = *sockResult;
+    void merge(const LoadStats& other) {
+        clients += other.clients;
+        sent += other.sent;
+        received += other.received;
+        timeouts += other.timeouts;
+        stale += other.stale;
+        send_errors += other.send_errors;
+        recv_errors += other.recv_errors;
+        for (size_t i = 0; i < kLatencyBuckets; ++i) {
+            rtt.counts[i] += other.rtt.counts[i];
+        }
+        rtt.samples += other.rtt.samples;
+        rtt.sum_ns += other.rtt.sum_ns;
+        rtt.max_ns = std::max(rtt.max_ns, other.rtt.max_ns);
+    }
+};
+
+struct SimulatedClient {
+    std::unique_ptr<Socket> socket;
+    std::optional<AsyncSocket> async;
+    uint32_t id;
+    uint32_t rng;
+};
 
-    bool waitingForResponse = false;
-    auto timeSinceLastSend = std::chrono::steady_clock::now();
-    auto maxWaitTime = std::chrono::milliseconds(1000 / 48); // 24Hz tick
+// Writes the probe header plus padding up to a size drawn from the configured range; returns the size
+size_t fillRequest(SimulatedClient& client, const LoadConfig& config, uint32_t seq, uint8_t* payload) {
+    client.rng ^= client.rng << 13; // xorshift32
+    client.rng ^= client.rng >> 17;
+    client.rng ^= client.rng << 5;
+    const size_t size = config.payload_min + client.rng % (config.payload_max - config.payload_min + 1);
 
-    std::vector<uint8_t> message = {'h', 'e', 'l', 'l', 'o'};
+    const ProbeHeader header{.client = client.id, .seq = seq, .sent_ns = Reactor::now()};
+    std::memcpy(payload, &header, sizeof(header));
+    return size;
+}
 
-    while (!stopFlag->load()) {
-        if (waitingForResponse &&
-            std::chrono::steady_clock::now() < timeSinceLastSend + maxWaitTime) {
-            auto maybe = client->recvFrom();
-            if (maybe.has_value()) {
-                waitingForResponse = false;
-                datagramCount->fetch_add(1);
-            } else if (maybe.error() != ErrorCode::WouldBlock) {
-                std::cerr << "recvFrom failed: " << static_cast<int>(maybe.error()) << std::endl;
-                waitingForResponse = false;
+std::optional<ProbeHeader> parseReply(const SimulatedClient& client, const std::expected<ReceivedPacket, ErrorCode>& reply) {
+    ProbeHeader header;
+    if (reply->length < sizeof(header)) {
+        return std::nullopt;
+    }
+    std::memcpy(&header, reply->data, sizeof(header));
+    if (header.client != client.id) {
+        return std::nullopt;
+    }
+    return header;
+}
+
+Task<void> closedLoopClient(Reactor& reactor, const LoadConfig& config, SimulatedClient& client,
+                            uint64_t firstTickNs, uint64_t endNs, LoadStats& stats) {
+    const uint64_t periodNs = 1'000'000'000ULL / config.tick_hz;
+    uint8_t payload[kMaxPayload] = {};
+
+    uint32_t seq = 0;
+    for (uint64_t tick = firstTickNs; tick < endNs; tick += periodNs, ++seq) {
+        co_await reactor.sleepUntil(tick);
+        const size_t size = fillRequest(client, config, seq, payload);
+        if (!co_await client.async->send(payload, size)) {
+            stats.send_errors++;
+            continue;
+        }
+        stats.sent++;
+
+        // The echo has until the next tick; anything older that turns up meanwhile is skipped
+        const uint64_t deadline = tick + periodNs;
+        while (true) {
+            const uint64_t now = Reactor::now();
+            auto reply = co_await client.async->recv(deadline > now ? deadline - now : 0);
+            if (!reply) {
+                if (reply.error() == ErrorCode::Timeout) {
+                    stats.timeouts++;
+                } else {
+                    stats.recv_errors++;
+                }
+                break;
             }
-        } else if (waitingForResponse) {
-            datagramTimeoutCount->fetch_add(1);
-            waitingForResponse = false;
+            auto header = parseReply(client, reply);
+            if (header && header->seq == seq) {
+                stats.record(Reactor::now() - header->sent_ns);
+                break;
+            }
+            stats.stale++;
+        }
+    }
+}
+
+Task<void> openLoopSender(Reactor& reactor, const LoadConfig& config, SimulatedClient& client,
+                          uint64_t firstTickNs, uint64_t endNs, LoadStats& stats) {
+    const uint64_t periodNs = 1'000'000'000ULL / config.tick_hz;
+    uint8_t payload[kMaxPayload] = {};
+
+    uint32_t seq = 0;
+    for (uint64_t tick = firstTickNs; tick < endNs; tick += periodNs, ++seq) {
+        co_await reactor.sleepUntil(tick);
+        const size_t size = fillRequest(client, config, seq, payload);
+        if (co_await client.async->send(payload, size)) {
+            stats.sent++;
         } else {
-            std::this_thread::sleep_for(maxWaitTime - (std::chrono::steady_clock::now() - timeSinceLastSend));
-            timeSinceLastSend = std::chrono::steady_clock::now();
-
-            auto result = client->send(message.data(), message.size());
-            if (!result) {
-                std::cerr << "send failed: " << static_cast<int>(result.error()) << std::endl;
-            } else {
-                waitingForResponse = true;
+            stats.send_errors++;
+        }
+    }
+}
+
+Task<void> openLoopReceiver(SimulatedClient& client, uint64_t stopNs, LoadStats& stats) {
+    while (true) {
+        const uint64_t now = Reactor::now();
+        if (now >= stopNs) {
+            co_return;
+        }
+        auto reply = co_await client.async->recv(stopNs - now);
+        if (!reply) {
+            if (reply.error() != ErrorCode::Timeout) {
+                stats.recv_errors++;
             }
+            continue;
+        }
+        if (auto header = parseReply(client, reply)) {
+            stats.record(Reactor::now() - header->sent_ns);
         }
     }
 }
 
-int handleClient(int concurrentClients = 10) {
-    const int numClients = concurrentClients;
-    std::atomic<uint64_t> datagramsSent(0);
-    std::atomic<uint64_t> datagramsTimedOut(0);
-    std::atomic<bool> stopFlag(false);
+void runLoadWorker(const LoadConfig& config, uint32_t firstClient, uint32_t clientCount,
+                   std::latch& ready, LoadStats& stats) {
+    auto reactorResult = Reactor::Create();
+    if (!reactorResult) {
+        std::cerr << "Failed to create a reactor: " << ErrorToString(reactorResult.error()) << std::endl;
+        ready.count_down();
+        return;
+    }
+    auto& reactor = *reactorResult;
 
-    std::vector<std::thread> clientThreads;
+    // Open every socket before the clock starts so setup time does not count against the first ticks
+    const Addr serverAddr(config.host, config.port);
+    std::vector<SimulatedClient> clients(clientCount);
+    uint32_t opened = 0;
+    for (; opened < clientCount; ++opened) {
+        auto& client = clients[opened];
+        auto socket = Dial(serverAddr);
+        if (!socket) {
+            std::cerr << "Failed to dial server for client " << firstClient + opened << ": " << ErrorToString(socket.error()) << std::endl;
+            break;
+        }
+        client.socket = std::move(*socket);
+        auto async = AsyncSocket::Attach(*reactor, *client.socket, kMaxPayload);
+        if (!async) {
+            std::cerr << "Failed to attach client " << firstClient + opened << ": " << ErrorToString(async.error()) << std::endl;
+            break;
+        }
+        client.async.emplace(std::move(*async));
+        client.id = firstClient + opened;
+        client.rng = client.id * 2654435761u + 1;
+    }
+    stats.clients = opened;
+    ready.arrive_and_wait();
 
-    auto startTime = std::chrono::steady_clock::now();
-    auto stopSignal = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    // Spread the clients' ticks evenly across one period instead of firing them all at once
+    const uint64_t periodNs = 1'000'000'000ULL / config.tick_hz;
+    const uint64_t startNs = Reactor::now() + 10'000'000;
+    const uint64_t endNs = startNs + uint64_t{config.duration_s} * 1'000'000'000ULL;
+    for (uint32_t i = 0; i < opened; ++i) {
+        const uint64_t firstTick = startNs + periodNs * (firstClient + i) / config.clients;
+        if (config.mode == LoadMode::Closed) {
+            reactor->spawn(closedLoopClient(*reactor, config, clients[i], firstTick, endNs, stats));
+        } else {
+            reactor->spawn(openLoopSender(*reactor, config, clients[i], firstTick, endNs, stats));
+            reactor->spawn(openLoopReceiver(clients[i], endNs + kOpenLoopDrainNs, stats));
+        }
+    }
 
-    std::cout << "Sending datagrams for 10 seconds on " << numClients << " clients..." << std::endl;
+    if (auto ran = reactor->run(); !ran) {
+        std::cerr << "Reactor failed: " << ErrorToString(ran.error()) << std::endl;
+    }
+}
 
-    for (int i = 0; i < numClients; ++i) {
-        clientThreads.emplace_back(sendDatagrams, "127.0.0.1", 9000, &datagramsSent, &datagramsTimedOut, &stopFlag);
+#if !defined(_WIN32)
+// Each simulated client holds a socket; lift the soft descriptor limit to the hard one so 10k+ clients fit
+void raiseDescriptorLimit(uint32_t clients) {
+    rlimit limit{};
+    if (::getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        ::setrlimit(RLIMIT_NOFILE, &limit);
     }
+    if (::getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY && limit.rlim_cur < clients + 64) {
+        std::cerr << "Descriptor limit " << limit.rlim_cur << " is too low for " << clients << " clients" << std::endl;
+    }
+}
+#endif
 
-    std::this_thread::sleep_until(stopSignal);
-    stopFlag.store(true);
+int handleClient(const LoadConfig& config) {
+#if !defined(_WIN32)
+    raiseDescriptorLimit(config.clients);
+#endif
+    const uint32_t threads = std::min(config.threads, config.clients);
+    std::cout << "Simulating " << config.clients << " clients on " << threads << " threads at " << config.tick_hz
+              << " Hz for " << config.duration_s << " seconds ("
+              << (config.mode == LoadMode::Closed ? "closed" : "open") << " loop, "
+              << config.payload_min << "-" << config.payload_max << " byte payloads)..." << std::endl;
 
-    for (auto& thread : clientThreads) {
-        if (thread.joinable()) thread.join();
+    std::vector<LoadStats> stats(threads);
+    std::latch ready(threads);
+    std::vector<std::thread> workers;
+    for (uint32_t t = 0; t < threads; ++t) {
+        const uint32_t first = static_cast<uint32_t>(uint64_t{config.clients} * t / threads);
+        const uint32_t last = static_cast<uint32_t>(uint64_t{config.clients} * (t + 1) / threads);
+        workers.emplace_back(runLoadWorker, std::cref(config), first, last - first, std::ref(ready), std::ref(stats[t]));
+    }
+    for (auto& worker : workers) {
+        worker.join();
     }
 
-    auto endTime = std::chrono::steady_clock::now();
-    auto elapsedTime = std::chrono::duration_cast<std::chrono::seconds>(endTime - startTime).count();
+    LoadStats total;
+    for (const auto& perThread : stats) {
+        total.merge(perThread);
+    }
 
+    const uint64_t lost = total.sent - std::min(total.sent, total.received);
+    const double lossPercent = total.sent ? 100.0 * static_cast<double>(lost) / static_cast<double>(total.sent) : 0.0;
     std::cout << "All clients stopped." << std::endl;
-    std::cout << "Elapsed time: " << elapsedTime << " seconds\n"
-              << "Total datagrams sent: " << datagramsSent.load() << "\n"
-              << "Average datagrams/sec: " << (datagramsSent.load() / elapsedTime) << "\n"
-              << "Average per client/sec: " << ((datagramsSent.load() / numClients) / elapsedTime) << "\n"
-              << "Total timeouts: " << datagramsTimedOut.load() << "\n"
-              << "Timeouts/sec: " << (datagramsTimedOut.load() / elapsedTime) << "\n"
-              << "Timeouts per client: " << (datagramsTimedOut.load() / numClients) << std::endl;
+    std::cout << "Clients connected: " << total.clients << " of " << config.clients << "\n"
+              << "Total datagrams sent: " << total.sent << "\n"
+              << "Total echoes received: " << total.received << "\n"
+              << "Average echoes/sec: " << total.received / config.duration_s << "\n"
+              << "Lost: " << lost << " (" << lossPercent << "%)\n"
+              << "Timeouts: " << total.timeouts << ", stale echoes: " << total.stale << "\n"
+              << "Send errors: " << total.send_errors << ", receive errors: " << total.recv_errors << "\n"
+              << "RTT mean/p50/p90/p99/p99.9/max us: "
+              << (total.rtt.samples ? total.rtt.sum_ns / total.rtt.samples / 1000 : 0) << " / "
+              << total.rtt.percentile(0.50) / 1000 << " / " << total.rtt.percentile(0.90) / 1000 << " / "
+              << total.rtt.percentile(0.99) / 1000 << " / " << total.rtt.percentile(0.999) / 1000 << " / "
+              << total.rtt.max_ns / 1000 << std::endl;
 
-    return 0;
+    return total.clients == config.clients ? 0 : 1;
+}
+
+// Parses "--client [clients] [options]"; nullopt on anything malformed
+std::optional<LoadConfig> parseClientArgs(int argc, char* argv[]) {
+    LoadConfig config;
+    int i = 2;
+    if (i < argc && argv[i][0] != '-') {
+        config.clients = static_cast<uint32_t>(std::strtoul(argv[i++], nullptr, 10));
+    }
+    for (; i + 1 < argc; i += 2) {
+        const std::string option = argv[i];
+        const std::string value = argv[i + 1];
+        if (option == "--threads") {
+            config.threads = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (option == "--tick-hz") {
+            config.tick_hz = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (option == "--duration-s") {
+            config.duration_s = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (option == "--payload") {
+            // "N" for a fixed size or "MIN-MAX" for a uniform spread
+            const auto dash = value.find('-');
+            config.payload_min = std::strtoul(value.substr(0, dash).c_str(), nullptr, 10);
+            config.payload_max = dash == std::string::npos ? config.payload_min : std::strtoul(value.substr(dash + 1).c_str(), nullptr, 10);
+        } else if (option == "--mode") {
+            if (value != "closed" && value != "open") {
+                return std::nullopt;
+            }
+            config.mode = value == "open" ? LoadMode::Open : LoadMode::Closed;
+        } else if (option == "--host") {
+            config.host = value;
+        } else if (option == "--port") {
+            config.port = static_cast<uint16_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    if (i != argc || config.clients == 0 || config.threads == 0 || config.tick_hz == 0 || config.duration_s == 0 ||
+        config.payload_min < sizeof(ProbeHeader) || config.payload_max < config.payload_min || config.payload_max > kMaxPayload) {
+        return std::nullopt;
+    }
+    return config;
+}
+
+// Parses "--server [options]"; nullopt on anything malformed
+std::optional<ServerConfig> parseServerArgs(int argc, char* argv[]) {
+    ServerConfig config;
+    int i = 2;
+    for (; i < argc; ++i) {
+        const std::string option = argv[i];
+        if (option == "--pin") {
+            config.pin = true;
+            continue;
+        }
+        if (i + 1 == argc) {
+            return std::nullopt;
+        }
+        const std::string value = argv[++i];
+        if (option == "--threads") {
+            config.threads = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (option == "--duration-s") {
+            config.duration_s = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (option == "--host") {
+            config.host = value;
+        } else if (option == "--port") {
+            config.port = static_cast<uint16_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else {
+            return std::nullopt;
+        }
+    }
+    return config;
 }
 
 int main(int argc, char* argv[]) {
     if (argc > 1 && std::string(argv[1]) == "--server") {
-        return handleServer();
+        if (auto config = parseServerArgs(argc, argv)) {
+            return handleServer(*config);
+        }
     } else if (argc > 1 && std::string(argv[1]) == "--client") {
-        int numClients = (argc > 2) ? std::stoi(argv[2]) : 10;
-        return handleClient(numClients);
-    } else {
-        std::cout << "Usage: " << argv[0] << " [--server | --client [numClients]]\n";
-        return 1;
+        if (auto config = parseClientArgs(argc, argv)) {
+            return handleClient(*config);
+        }
     }
+    std::cout << "Usage: " << argv[0] << " --server [--threads N] [--pin] [--duration-s S] [--host IP] [--port PORT]\n"
+              << "       " << argv[0] << " --client [clients] [--threads N] [--tick-hz HZ] [--duration-s S]\n"
+              << "              [--payload BYTES|MIN-MAX] [--mode closed|open] [--host IP] [--port PORT]\n";
+    return 1;
 }
@@ -1,5 +1,2062 @@
 #include <iostream>
+#include <thread>
+#include <algorithm>
+#include <vector>
+#include <cstring>
+#include <unordered_map>
 #include <pulse/net/udp/udp.h>
+#include <pulse/net/udp/packet_pool.h>
+#include <pulse/net/udp/packet_ring.h>
+#include <pulse/net/udp/poller.h>
+#include <pulse/net/udp/listen_group.h>
+#include <pulse/net/udp/peer_session.h>
+#include <pulse/net/udp/reactor.h>
+#include <pulse/net/udp/receive_driver.h>
+#include <pulse/net/udp/send_queue.h>
+#include <pulse/net/udp/session_table.h>
+#include <chrono>
+
+#if !defined(_WIN32)
+#include <netinet/in.h>
+#endif
+
+int testRecvBatch() {
+    using namespace pulse::net::udp;
+
+    std::cout << "Testing batched receive..." << std::endl;
+    Addr serverAddr("127.0.0.1", 12346);
+    auto serverResult = Listen(serverAddr);
+    if (!serverResult) {
+        std::cerr << "Failed to create batch server socket: " << static_cast<int>(serverResult.error()) << std::endl;
+        return 1;
+    }
+    auto clientResult = Dial(serverAddr);
+    if (!clientResult) {
+        std::cerr << "Failed to create batch client socket: " << static_cast<int>(clientResult.error()) << std::endl;
+        return 1;
+    }
+    auto& server = *serverResult;
+    auto& client = *clientResult;
+
+    auto empty = server->recvBatch(std::span<ReceivedPacket>{});
+    if (!empty || *empty != 0) {
+        std::cerr << "recvBatch with no slots should return 0." << std::endl;
+        return 1;
+    }
+
+    ReceivedPacket packets[16];
+    auto idle = server->recvBatch(packets);
+    if (idle || idle.error() != ErrorCode::WouldBlock) {
+        std::cerr << "recvBatch on an idle socket should report WouldBlock." << std::endl;
+        return 1;
+    }
+
+    constexpr uint8_t datagramCount = 10;
+    for (uint8_t i = 0; i < datagramCount; ++i) {
+        uint8_t payload[2] = {'b', i};
+        if (auto sent = client->send(payload, sizeof(payload)); !sent) {
+            std::cerr << "Failed to send batch datagram " << static_cast<int>(i) << ": " << static_cast<int>(sent.error()) << std::endl;
+            return 1;
+        }
+    }
+
+    size_t total = 0;
+    while (total < datagramCount) {
+        auto received = server->recvBatch(std::span(packets).subspan(0, 4));
+        if (!received) {
+            std::cerr << "recvBatch failed after " << total << " datagrams: " << static_cast<int>(received.error()) << std::endl;
+            return 1;
+        }
+        if (*received > 4) {
+            std::cerr << "recvBatch filled more slots than provided: " << *received << std::endl;
+            return 1;
+        }
+        for (size_t i = 0; i < *received; ++i) {
+            const auto& packet = packets[i];
+            if (packet.length != 2 || packet.data[0] != 'b' || packet.data[1] != total) {
+                std::cerr << "Batch datagram " << total << " has unexpected contents." << std::endl;
+                return 1;
+            }
+            ++total;
+        }
+    }
+
+    std::cout << "Received " << total << " datagrams via recvBatch." << std::endl;
+    return 0;
+}
+
+int testSendBatch() {
+    using namespace pulse::net::udp;
+
+    std::cout << "Testing batched send..." << std::endl;
+    Addr senderAddr("127.0.0.1", 12347);
+    Addr peerAddrA("127.0.0.1", 12348);
+    Addr peerAddrB("127.0.0.1", 12349);
+    auto senderResult = Listen(senderAddr);
+    auto peerResultA = Listen(peerAddrA);
+    auto peerResultB = Listen(peerAddrB);
+    if (!senderResult || !peerResultA || !peerResultB) {
+        std::cerr << "Failed to create batch send sockets." << std::endl;
+        return 1;
+    }
+    auto& sender = *senderResult;
+
+    auto none = sender->sendBatch(std::span<const OutgoingPacket>{});
+    if (!none || *none != 0) {
+        std::cerr << "sendBatch with no packets should return 0." << std::endl;
+        return 1;
+    }
+
+    constexpr size_t datagramCount = 6;
+    uint8_t payloads[datagramCount][2];
+    OutgoingPacket outgoing[datagramCount];
+    for (size_t i = 0; i < datagramCount; ++i) {
+        payloads[i][0] = 's';
+        payloads[i][1] = static_cast<uint8_t>(i);
+        outgoing[i] = OutgoingPacket{
+            .addr = Endpoint::FromAddr((i % 2 == 0) ? peerAddrA : peerAddrB),
+            .data = payloads[i],
+            .length = sizeof(payloads[i])
+        };
+    }
+
+    auto sent = sender->sendBatch(outgoing);
+    if (!sent || *sent != datagramCount) {
+        std::cerr << "sendBatch accepted " << (sent ? *sent : 0) << " of " << datagramCount << " datagrams." << std::endl;
+        return 1;
+    }
+
+    Socket* peers[2] = {peerResultA->get(), peerResultB->get()};
+    for (size_t p = 0; p < 2; ++p) {
+        ReceivedPacket packets[datagramCount];
+        auto received = peers[p]->recvBatch(packets);
+        if (!received || *received != datagramCount / 2) {
+            std::cerr << "Peer " << p << " expected " << datagramCount / 2 << " datagrams from sendBatch." << std::endl;
+            return 1;
+        }
+        for (size_t i = 0; i < *received; ++i) {
+            if (packets[i].length != 2 || packets[i].data[1] != p + 2 * i || packets[i].addr.port() != senderAddr.port) {
+                std::cerr << "Peer " << p << " received an unexpected datagram at index " << i << "." << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    // An unspecified destination on a dialed socket goes to the connected address
+    auto dialResult = Dial(peerAddrA);
+    if (!dialResult) {
+        std::cerr << "Failed to dial batch peer: " << static_cast<int>(dialResult.error()) << std::endl;
+        return 1;
+    }
+    OutgoingPacket connected{.addr = {}, .data = payloads[0], .length = sizeof(payloads[0])};
+    auto connectedSent = (*dialResult)->sendBatch(std::span(&connected, 1));
+    if (!connectedSent || *connectedSent != 1) {
+        std::cerr << "sendBatch to the connected address failed." << std::endl;
+        return 1;
+    }
+    if (auto packet = (*peerResultA)->recvFrom(); !packet || packet->length != 2) {
+        std::cerr << "Connected sendBatch datagram was not received." << std::endl;
+        return 1;
+    }
+
+    std::cout << "Sent " << datagramCount << " datagrams to two peers via sendBatch." << std::endl;
+    return 0;
+}
+
+int testEndpoint() {
+    using namespace pulse::net::udp;
+
+    std::cout << "Testing binary endpoints..." << std::endl;
+    Endpoint v4 = Endpoint::FromAddr(Addr("127.0.0.1", 12350));
+    Endpoint v6 = Endpoint::FromAddr(Addr("::1", 12350));
+    if (!v4.isV4() || v4.port() != 12350 || v4.toString() != "127.0.0.1:12350") {
+        std::cerr << "IPv4 endpoint decoded incorrectly: " << v4.toString() << std::endl;
+        return 1;
+    }
+    if (!v6.isV6() || v6.toString() != "[::1]:12350") {
+        std::cerr << "IPv6 endpoint decoded incorrectly: " << v6.toString() << std::endl;
+        return 1;
+    }
+    if (v4 == v6 || !(v4 == Endpoint::FromAddr(v4.toAddr())) || v4.hash() != Endpoint::FromAddr(v4.toAddr()).hash()) {
+        std::cerr << "Endpoint equality/hash is inconsistent." << std::endl;
+        return 1;
+    }
+    if (Endpoint{}.isSpecified()) {
+        std::cerr << "Default endpoint should be unspecified." << std::endl;
+        return 1;
+    }
+
+#if !defined(_WIN32)
+    // A link-local peer is only reachable through its interface, so the scope id must survive the round trip
+    sockaddr_in6 linkLocal{};
+    linkLocal.sin6_family = AF_INET6;
+    linkLocal.sin6_port = htons(12350);
+    linkLocal.sin6_addr.s6_addr[0] = 0xfe;
+    linkLocal.sin6_addr.s6_addr[1] = 0x80;
+    linkLocal.sin6_addr.s6_addr[15] = 1;
+    linkLocal.sin6_scope_id = 2;
+    const Endpoint scoped = Endpoint::FromSockaddr(&linkLocal);
+    sockaddr_in6 encoded{};
+    if (scoped.scopeId() != 2 || scoped.toString() != "[fe80::1%2]:12350" ||
+        scoped.toSockaddr(&encoded) != sizeof(encoded) || encoded.sin6_scope_id != 2) {
+        std::cerr << "IPv6 scope id was lost: " << scoped.toString() << std::endl;
+        return 1;
+    }
+    linkLocal.sin6_scope_id = 3;
+    if (scoped == Endpoint::FromSockaddr(&linkLocal)) {
+        std::cerr << "Link-local endpoints on different interfaces should differ." << std::endl;
+        return 1;
+    }
+#endif
+
+    // Echo back to the received endpoint without going through Addr
+    auto serverResult = Listen(Addr("127.0.0.1", 12350));
+    auto clientResult = Dial(Addr("127.0.0.1", 12350));
+    if (!serverResult || !clientResult) {
+        std::cerr << "Failed to create endpoint echo sockets." << std::endl;
+        return 1;
+    }
+    auto& server = *serverResult;
+    auto& client = *clientResult;
+
+    const uint8_t ping[] = {'p', 'i', 'n', 'g'};
+    if (auto sent = client->send(ping, sizeof(ping)); !sent) {
+        std::cerr << "Failed to send endpoint ping: " << static_cast<int>(sent.error()) << std::endl;
+        return 1;
+    }
+    auto request = server->recvFrom();
+    if (!request || !request->addr.isV4()) {
+        std::cerr << "Endpoint ping was not received." << std::endl;
+        return 1;
+    }
+    if (auto sent = server->sendTo(request->addr, request->data, request->length); !sent) {
+        std::cerr << "sendTo(Endpoint) failed: " << static_cast<int>(sent.error()) << std::endl;
+        return 1;
+    }
+    auto reply = client->recvFrom();
+    if (!reply || reply->length != sizeof(ping) || !(reply->addr == v4)) {
+        std::cerr << "Endpoint echo reply did not match." << std::endl;
+        return 1;
+    }
+
+    if (auto sent = server->sendTo(Endpoint{}, ping, sizeof(ping)); sent || sent.error() != ErrorCode::InvalidAddress) {
+        std::cerr << "sendTo an unspecified endpoint should fail with InvalidAddress." << std::endl;
+        return 1;
+    }
+
+    std::cout << "Endpoint round trip via " << request->addr.toString() << " succeeded." << std::endl;
+    return 0;
+}
+
+int testSendSegmented() {
+    using namespace pulse::net::udp;
+
+    std::cout << "Testing segmented (GSO) send..." << std::endl;
+    Addr receiverAddr("127.0.0.1", 12351);
+    auto receiverResult = Listen(receiverAddr);
+    auto senderResult = Listen(Addr("127.0.0.1", 12352));
+    if (!receiverResult || !senderResult) {
+        std::cerr << "Failed to create segmented send sockets." << std::endl;
+        return 1;
+    }
+    auto& receiver = *receiverResult;
+    auto& sender = *senderResult;
+
+    constexpr size_t segmentSize = 100;
+    constexpr size_t totalBytes = 10 * segmentSize + 50;
+    uint8_t payload[totalBytes];
+    for (size_t i = 0; i < totalBytes; ++i) {
+        payload[i] = static_cast<uint8_t>(i / segmentSize);
+    }
+
+    if (auto bad = sender->sendSegmented(Endpoint::FromAddr(receiverAddr), payload, totalBytes, 0); bad || bad.error() != ErrorCode::InvalidArgument) {
+        std::cerr << "sendSegmented with a zero segment size should fail with InvalidArgument." << std::endl;
+        return 1;
+    }
+
+    auto sent = sender->sendSegmented(Endpoint::FromAddr(receiverAddr), payload, totalBytes, segmentSize);
+    if (!sent || *sent != 11) {
+        std::cerr << "sendSegmented accepted " << (sent ? *sent : 0) << " of 11 segments." << std::endl;
+        return 1;
+    }
+
+    size_t segments = 0;
+    ReceivedPacket packets[16];
+    while (segments < 11) {
+        auto received = receiver->recvBatch(packets);
+        if (!received) {
+            std::cerr << "Receiving segments failed after " << segments << ": " << static_cast<int>(received.error()) << std::endl;
+            return 1;
+        }
+        for (size_t i = 0; i < *received; ++i, ++segments) {
+            const size_t expectedLength = (segments == 10) ? 50 : segmentSize;
+            if (packets[i].length != expectedLength || packets[i].data[0] != segments || packets[i].data[expectedLength - 1] != segments) {
+                std::cerr << "Segment " << segments << " arrived with length " << packets[i].length << " or wrong contents." << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    std::cout << "Received " << segments << " datagrams from one sendSegmented call." << std::endl;
+    return 0;
+}
+
+int testRecvCoalesced() {
+    using namespace pulse::net::udp;
+
+    std::cout << "Testing coalesced (GRO) receive..." << std::endl;
+    Addr receiverAddr("127.0.0.1", 12353);
+#if defined(__linux__)
+    // Timestamp and drop-counter messages share the control buffer with the GRO segment size
+    auto receiverResult = Listen(receiverAddr, SocketConfig{.rx_timestamps = true, .rx_drop_counter = true});
+#else
+    auto receiverResult = Listen(receiverAddr);
+#endif
+    auto senderResult = Listen(Addr("127.0.0.1", 12354));
+    if (!receiverResult || !senderResult) {
+        std::cerr << "Failed to create coalesced receive sockets." << std::endl;
+        return 1;
+    }
+    auto& receiver = *receiverResult;
+    auto& sender = *senderResult;
+
+    if (auto gro = receiver->enableGro(); !gro) {
+        if (gro.error() != ErrorCode::NotSupported) {
+            std::cerr << "enableGro failed: " << ErrorToString(gro.error()) << std::endl;
+            return 1;
+        }
+        std::cout << "UDP GRO not supported here; checking single-segment delivery." << std::endl;
+    }
+
+    constexpr size_t segmentSize = 200;
+    constexpr size_t totalBytes = 20 * segmentSize + 10;
+    uint8_t payload[totalBytes];
+    for (size_t i = 0; i < totalBytes; ++i) {
+        payload[i] = static_cast<uint8_t>(i / segmentSize);
+    }
+
+    auto sent = sender->sendSegmented(Endpoint::FromAddr(receiverAddr), payload, totalBytes, segmentSize);
+    if (!sent || *sent != 21) {
+        std::cerr << "sendSegmented accepted " << (sent ? *sent : 0) << " of 21 segments." << std::endl;
+        return 1;
+    }
+
+    size_t segments = 0;
+    size_t receives = 0;
+    while (segments < 21) {
+        auto packet = receiver->recvCoalesced();
+        if (!packet) {
+            std::cerr << "recvCoalesced failed after " << segments << " segments: " << ErrorToString(packet.error()) << std::endl;
+            return 1;
+        }
+        ++receives;
+        size_t counted = 0;
+        for (auto segment : packet->segments()) {
+            const size_t expectedLength = (segments == 20) ? 10 : segmentSize;
+            if (segment.size() != expectedLength || segment.front() != segments || segment.back() != segments) {
+                std::cerr << "Coalesced segment " << segments << " has length " << segment.size() << " or wrong contents." << std::endl;
+                return 1;
+            }
+            ++segments;
+            ++counted;
+        }
+        if (counted != packet->segmentCount()) {
+            std::cerr << "Segment iterator yielded " << counted << " of " << packet->segmentCount() << " segments." << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "Received " << segments << " segments in " << receives << " coalesced receive(s)." << std::endl;
+    return 0;
+}
+
+int testCallerOwnedBuffers() {
+    using namespace pulse::net::udp;
+
+    std::cout << "Testing caller-owned receive buffers..." << std::endl;
+    Addr serverAddr("127.0.0.1", 12355);
+    auto serverResult = Listen(serverAddr);
+    auto clientResult = Dial(serverAddr);
+    if (!serverResult || !clientResult) {
+        std::cerr << "Failed to create caller-owned buffer sockets." << std::endl;
+        return 1;
+    }
+    auto& server = *serverResult;
+    auto& client = *clientResult;
+
+    if (PacketBuffer::Create(0) || PacketBuffer::Create(kMaxDatagramSize + 1)) {
+        std::cerr << "PacketBuffer::Create should reject zero and oversized capacities." << std::endl;
+        return 1;
+    }
+
+    // Larger than the default 2048-byte receive buffer
+    std::vector<uint8_t> large(4000);
+    for (size_t i = 0; i < large.size(); ++i) {
+        large[i] = static_cast<uint8_t>(i * 7);
+    }
+    if (auto sent = client->send(large.data(), large.size()); !sent) {
+        std::cerr << "Failed to send large datagram: " << ErrorToString(sent.error()) << std::endl;
+        return 1;
+    }
+
+    std::vector<uint8_t> storage(8192);
+    auto packet = server->recvFrom(std::span(storage));
+    if (!packet || packet->data != storage.data() || packet->length != large.size() ||
+        !std::equal(large.begin(), large.end(), storage.begin())) {
+        std::cerr << "recvFrom(span) did not deliver the full datagram into the caller's buffer." << std::endl;
+        return 1;
+    }
+
+    auto bufferResult = PacketBuffer::Create(kMaxDatagramSize);
+    if (!bufferResult) {
+        std::cerr << "PacketBuffer::Create failed: " << ErrorToString(bufferResult.error()) << std::endl;
+        return 1;
+    }
+    PacketBuffer owned = std::move(*bufferResult);
+
+    if (auto empty = server->recvInto(owned); empty || empty.error() != ErrorCode::WouldBlock) {
+        std::cerr << "recvInto on an idle socket should report WouldBlock." << std::endl;
+        return 1;
+    }
+
+    if (auto sent = client->send(large.data(), large.size()); !sent) {
+        std::cerr << "Failed to send large datagram: " << ErrorToString(sent.error()) << std::endl;
+        return 1;
+    }
+    if (auto received = server->recvInto(owned); !received) {
+        std::cerr << "recvInto failed: " << ErrorToString(received.error()) << std::endl;
+        return 1;
+    }
+
+    // Hand the owned packet to another thread; no copy, and later receives cannot clobber it
+    bool matches = false;
+    std::thread worker([&matches, packet = std::move(owned), &large]() {
+        matches = packet.size() == large.size() && packet.addr().isV4() &&
+                  std::equal(large.begin(), large.end(), packet.data());
+    });
+    worker.join();
+
+    if (!matches || owned) {
+        std::cerr << "Owned packet contents did not survive the cross-thread handoff." << std::endl;
+        return 1;
+    }
+
+    std::cout << "Caller-owned and owned-handle receives delivered " << large.size() << " bytes." << std::endl;
+    return 0;
+}
+
+int testPacketPool() {
+    using namespace pulse::net::udp;
+
+    std::cout << "Testing packet buffer pool..." << std::endl;
+    if (PacketPool::Create(PacketPoolConfig{.mtu_buffers = 0, .jumbo_buffers = 0})) {
+        std::cerr << "PacketPool::Create should reject a pool with no buffers." << std::endl;
+        return 1;
+    }
+
+    auto poolResult = PacketPool::Create(PacketPoolConfig{.mtu_buffers = 4, .jumbo_buffers = 1, .thread_cache_size = 2});
+    if (!poolResult) {
+        std::cerr << "PacketPool::Create failed: " << ErrorToString(poolResult.error()) << std::endl;
+        return 1;
+    }
+    auto& pool = *poolResult;
+
+    std::vector<PacketBuffer> held;
+    for (int i = 0; i < 4; ++i) {
+        auto buffer = pool->acquire();
+        if (!buffer || buffer->capacity() != kMtuBufferSize) {
+            std::cerr << "MTU acquire " << i << " failed." << std::endl;
+            return 1;
+        }
+        held.push_back(std::move(*buffer));
+    }
+    if (auto extra = pool->acquire(); extra || extra.error() != ErrorCode::PoolExhausted) {
+        std::cerr << "Acquire beyond the MTU class should report PoolExhausted." << std::endl;
+        return 1;
+    }
+    if (auto tooBig = pool->acquire(kJumboBufferSize + 1); tooBig || tooBig.error() != ErrorCode::InvalidArgument) {
+        std::cerr << "Acquire above the jumbo size should report InvalidArgument." << std::endl;
+        return 1;
+    }
+
+    auto stats = pool->stats();
+    if (stats.mtu_in_use != 4 || stats.mtu_high_water != 4 || stats.exhausted != 1) {
+        std::cerr << "Pool stats after exhaustion: in_use=" << stats.mtu_in_use << " high_water=" << stats.mtu_high_water
+                  << " exhausted=" << stats.exhausted << std::endl;
+        return 1;
+    }
+
+    // Receive a jumbo datagram straight into pooled storage
+    Addr serverAddr("127.0.0.1", 12356);
+    auto serverResult = Listen(serverAddr);
+    auto clientResult = Dial(serverAddr);
+    if (!serverResult || !clientResult) {
+        std::cerr << "Failed to create pool test sockets." << std::endl;
+        return 1;
+    }
+    std::vector<uint8_t> large(6000, 0x5a);
+    if (auto sent = (*clientResult)->send(large.data(), large.size()); !sent) {
+        std::cerr << "Failed to send pooled datagram: " << ErrorToString(sent.error()) << std::endl;
+        return 1;
+    }
+    auto jumbo = pool->acquire(large.size());
+    if (!jumbo || jumbo->capacity() != kJumboBufferSize) {
+        std::cerr << "Jumbo acquire failed." << std::endl;
+        return 1;
+    }
+    if (auto received = (*serverResult)->recvInto(*jumbo); !received || jumbo->size() != large.size()) {
+        std::cerr << "recvInto a pooled buffer failed." << std::endl;
+        return 1;
+    }
+
+    // Free one buffer on another thread; it must come back through the shared list
+    std::thread([buffer = std::move(held.back())]() mutable {
+        buffer = PacketBuffer{};
+    }).join();
+    held.pop_back();
+    held.clear();
+    *jumbo = PacketBuffer{};
+
+    stats = pool->stats();
+    if (stats.mtu_in_use != 0 || stats.jumbo_in_use != 0 || stats.jumbo_high_water != 1 || stats.cross_thread_frees != 1) {
+        std::cerr << "Pool stats after release: mtu_in_use=" << stats.mtu_in_use << " jumbo_in_use=" << stats.jumbo_in_use
+                  << " cross_thread_frees=" << stats.cross_thread_frees << std::endl;
+        return 1;
+    }
+
+    for (int i = 0; i < 4; ++i) {
+        auto buffer = pool->acquire();
+        if (!buffer) {
+            std::cerr << "Released buffers were not reusable: " << ErrorToString(buffer.error()) << std::endl;
+            return 1;
+        }
+        held.push_back(std::move(*buffer));
+    }
+    held.clear();
+
+    std::cout << "Packet pool recycled buffers across threads." << std::endl;
+    return 0;
+}
+
+int testPoller() {
+    using namespace pulse::net::udp;
+
+    std::cout << "Testing readiness poller..." << std::endl;
+    auto pollerResult = Poller::Create();
+    if (!pollerResult) {
+        std::cerr << "Poller::Create failed: " << ErrorToString(pollerResult.error()) << std::endl;
+        return 1;
+    }
+    auto& poller = *pollerResult;
+
+    // An empty set can only time out; waiting on it forever must fail instead of hanging
+    if (auto empty = poller->wait(0); !empty || !empty->empty()) {
+        std::cerr << "An empty poller should time out immediately." << std::endl;
+        return 1;
+    }
+    if (auto forever = poller->wait(kWaitForever); forever || forever.error() != ErrorCode::InvalidArgument) {
+        std::cerr << "An infinite wait on an empty poller should fail with InvalidArgument." << std::endl;
+        return 1;
+    }
+
+    Addr addrA("127.0.0.1", 12357);
+    Addr addrB("127.0.0.1", 12358);
+    auto socketA = Listen(addrA);
+    auto socketB = Listen(addrB);
+    auto client = Dial(addrB);
+    if (!socketA || !socketB || !client) {
+        std::cerr << "Failed to create poller test sockets." << std::endl;
+        return 1;
+    }
+
+    if (!poller->add(**socketA, 1) || !poller->add(**socketB, 2)) {
+        std::cerr << "Failed to register sockets with the poller." << std::endl;
+        return 1;
+    }
+    if (auto dup = poller->add(**socketA, 3); dup || dup.error() != ErrorCode::InvalidArgument) {
+        std::cerr << "Registering a socket twice should report InvalidArgument." << std::endl;
+        return 1;
+    }
+
+    auto idle = poller->wait(0);
+    if (!idle || !idle->empty()) {
+        std::cerr << "A zero-timeout wait on idle sockets should return no events." << std::endl;
+        return 1;
+    }
+
+    const auto waitStart = std::chrono::steady_clock::now();
+    auto timedOut = poller->wait(5'000'000);
+    const auto waited = std::chrono::steady_clock::now() - waitStart;
+    if (!timedOut || !timedOut->empty() || waited < std::chrono::milliseconds(5)) {
+        std::cerr << "A 5ms wait returned early or with events." << std::endl;
+        return 1;
+    }
+
+    const uint8_t ping[] = {'p'};
+    if (!(*client)->send(ping, sizeof(ping))) {
+        std::cerr << "Failed to send poller ping." << std::endl;
+        return 1;
+    }
+
+    auto ready = poller->wait(1'000'000'000);
+    if (!ready || ready->size() != 1 || (*ready)[0].token != 2 || !(*ready)[0].readable || (*ready)[0].socket != socketB->get()) {
+        std::cerr << "Expected exactly socket B (token 2) to be readable." << std::endl;
+        return 1;
+    }
+    if (!(*socketB)->recvFrom()) {
+        std::cerr << "Readable socket had nothing to receive." << std::endl;
+        return 1;
+    }
+
+    if (!poller->modify(**socketA, PollInterest{.readable = true, .writable = true})) {
+        std::cerr << "Failed to add writable interest." << std::endl;
+        return 1;
+    }
+    auto writable = poller->wait(0);
+    if (!writable || writable->size() != 1 || (*writable)[0].token != 1 || !(*writable)[0].writable) {
+        std::cerr << "Expected socket A (token 1) to report writable." << std::endl;
+        return 1;
+    }
+
+    if (!poller->remove(**socketA) || poller->remove(**socketA)) {
+        std::cerr << "remove() should succeed once and then report the socket unknown." << std::endl;
+        return 1;
+    }
+    auto afterRemove = poller->wait(0);
+    if (!afterRemove || !afterRemove->empty()) {
+        std::cerr << "A removed socket still produced events." << std::endl;
+        return 1;
+    }
+
+    // A closed socket can still be removed, and a new socket that inherits its fd registers cleanly
+    const int closedFd = *(*socketB)->getHandle();
+    (*socketB)->close();
+    if (!poller->remove(**socketB)) {
+        std::cerr << "remove() should accept a socket that was already closed." << std::endl;
+        return 1;
+    }
+    auto reused = Listen(Addr("127.0.0.1", 12380));
+    if (!reused || *(*reused)->getHandle() != closedFd) {
+        std::cerr << "Expected the replacement socket to reuse the closed fd." << std::endl;
+        return 1;
+    }
+    if (!poller->add(**reused, 4)) {
+        std::cerr << "Registering a socket on a reused fd failed." << std::endl;
+        return 1;
+    }
+    auto reusedClient = Dial(Addr("127.0.0.1", 12380));
+    if (!reusedClient || !(*reusedClient)->send(ping, sizeof(ping))) {
+        std::cerr << "Failed to send to the replacement socket." << std::endl;
+        return 1;
+    }
+    auto reusedReady = poller->wait(1'000'000'000);
+    if (!reusedReady || reusedReady->size() != 1 || (*reusedReady)[0].token != 4 || (*reusedReady)[0].socket != reused->get()) {
+        std::cerr << "Expected the replacement socket (token 4) to be readable." << std::endl;
+        return 1;
+    }
+
+    std::cout << "Poller reported readable and writable sockets." << std::endl;
+    return 0;
+}
+
+int testListenGroup() {
+    using namespace pulse::net::udp;
+
+    std::cout << "Testing SO_REUSEPORT listen group..." << std::endl;
+    Addr addr("127.0.0.1", 12359);
+    auto groupResult = ListenGroup(addr, ListenGroupConfig{.socket_count = 4, .pin_to_cpu = true, .socket = {}});
+    if (!groupResult) {
+        std::cerr << "ListenGroup failed: " << ErrorToString(groupResult.error()) << std::endl;
+        return 1;
+    }
+    auto& group = *groupResult;
+    if (group.size() != 4) {
+        std::cerr << "Expected 4 group members, got " << group.size() << std::endl;
+        return 1;
+    }
+
+    // A socket without SO_REUSEPORT must not be able to join the group
+    if (auto intruder = Listen(addr); intruder || intruder.error() != ErrorCode::BindFailed) {
+        std::cerr << "Plain Listen on a group port should fail with BindFailed." << std::endl;
+        return 1;
+    }
+
+    if (!PinCurrentThread(0)) {
+        std::cerr << "PinCurrentThread(0) failed." << std::endl;
+        return 1;
+    }
+
+    constexpr size_t clientCount = 32;
+    std::vector<std::unique_ptr<Socket>> clients;
+    for (size_t i = 0; i < clientCount; ++i) {
+        auto client = Dial(addr);
+        if (!client) {
+            std::cerr << "Dial failed for group client " << i << std::endl;
+            return 1;
+        }
+        const uint8_t payload[] = {static_cast<uint8_t>(i)};
+        if (!(*client)->send(payload, sizeof(payload))) {
+            std::cerr << "Send failed for group client " << i << std::endl;
+            return 1;
+        }
+        clients.push_back(std::move(*client));
+    }
+
+    auto poller = Poller::Create();
+    if (!poller) {
+        std::cerr << "Poller::Create failed." << std::endl;
+        return 1;
+    }
+    for (size_t i = 0; i < group.size(); ++i) {
+        (*poller)->add(*group[i], i);
+    }
+
+    std::vector<size_t> perSocket(group.size(), 0);
+    size_t received = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (received < clientCount && std::chrono::steady_clock::now() < deadline) {
+        auto ready = (*poller)->wait(100'000'000);
+        if (!ready) {
+            std::cerr << "Poller wait failed." << std::endl;
+            return 1;
+        }
+        for (const auto& ev : *ready) {
+            while (ev.socket->recvFrom()) {
+                perSocket[ev.token]++;
+                received++;
+            }
+        }
+    }
+
+    if (received != clientCount) {
+        std::cerr << "Group received " << received << " of " << clientCount << " datagrams." << std::endl;
+        return 1;
+    }
+
+    const size_t activeSockets = static_cast<size_t>(std::count_if(perSocket.begin(), perSocket.end(), [](size_t n) { return n > 0; }));
+    if (activeSockets < 2) {
+        std::cerr << "Expected flows to spread across the group, but only one socket saw traffic." << std::endl;
+        return 1;
+    }
+
+    std::cout << "Listen group spread " << clientCount << " flows across " << activeSockets << " sockets." << std::endl;
+    return 0;
+}
+
+int testListenSteering() {
+    using namespace pulse::net::udp;
+
+    std::cout << "Testing reuseport CBPF steering..." << std::endl;
+    Addr addr("127.0.0.1", 12360);
+    auto groupResult = ListenGroup(addr, ListenGroupConfig{
+        .socket_count = 4,
+        .steering = ListenSteering::PayloadKey,
+        .steering_key_offset = 1,
+        .steering_key_size = 2,
+        .socket = {}
+    });
+    if (!groupResult) {
+        std::cerr << "Steered ListenGroup failed: " << ErrorToString(groupResult.error()) << std::endl;
+        return 1;
+    }
+    auto& group = *groupResult;
+
+    if (auto bad = ListenGroup(Addr("127.0.0.1", 12361), ListenGroupConfig{.socket_count = 2, .steering = ListenSteering::PayloadKey, .steering_key_size = 3, .socket = {}});
+        bad || bad.error() != ErrorCode::InvalidArgument) {
+        std::cerr << "A 3-byte steering key should be rejected with InvalidArgument." << std::endl;
+        return 1;
+    }
+
+    // Every session id must land on socket (id % 4), whichever client port it comes from
+    constexpr uint16_t sessionCount = 16;
+    std::vector<std::unique_ptr<Socket>> clients;
+    for (uint16_t session = 0; session < sessionCount; ++session) {
+        auto client = Dial(addr);
+        if (!client) {
+            std::cerr << "Dial failed for session " << session << std::endl;
+            return 1;
+        }
+        const uint8_t payload[] = {0xAB, static_cast<uint8_t>(session >> 8), static_cast<uint8_t>(session & 0xFF), 0x00};
+        if (!(*client)->send(payload, sizeof(payload))) {
+            std::cerr << "Send failed for session " << session << std::endl;
+            return 1;
+        }
+        clients.push_back(std::move(*client));
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    size_t received = 0;
+    for (size_t i = 0; i < group.size(); ++i) {
+        while (auto packet = group[i]->recvFrom()) {
+            const auto& [data, length, sender, rxTimestampNs, drops, truncated, datagramLength] = *packet;
+            const uint16_t session = static_cast<uint16_t>(data[1] << 8 | data[2]);
+            if (session % group.size() != i) {
+                std::cerr << "Session " << session << " was steered to socket " << i << std::endl;
+                return 1;
+            }
+            received++;
+        }
+    }
+
+    if (received != sessionCount) {
+        std::cerr << "Steered group received " << received << " of " << sessionCount << " datagrams." << std::endl;
+        return 1;
+    }
+
+    auto cpuGroup = ListenGroup(Addr("127.0.0.1", 12362), ListenGroupConfig{.socket_count = 2, .steering = ListenSteering::Cpu, .socket = {}});
+    if (!cpuGroup) {
+        std::cerr << "CPU-steered ListenGroup failed: " << ErrorToString(cpuGroup.error()) << std::endl;
+        return 1;
+    }
+
+    std::cout << "Payload-key steering placed all " << sessionCount << " sessions correctly." << std::endl;
+    return 0;
+}
+
+int testUringBackend() {
+    using namespace pulse::net::udp;
+
+    std::cout << "Testing io_uring backend..." << std::endl;
+    const SocketConfig uring{.backend = SocketBackend::IoUring};
+    Addr serverAddr("127.0.0.1", 12363);
+    auto serverResult = Listen(serverAddr, uring);
+    if (!serverResult && serverResult.error() == ErrorCode::NotSupported) {
+        std::cout << "io_uring backend not supported here, skipping." << std::endl;
+        return 0;
+    }
+    auto clientResult = Dial(serverAddr, uring);
+    if (!serverResult || !clientResult) {
+        std::cerr << "Failed to open io_uring sockets." << std::endl;
+        return 1;
+    }
+    auto& server = *serverResult;
+    auto& client = *clientResult;
+
+    auto poller = Poller::Create();
+    if (!poller || !(*poller)->add(*server, 1)) {
+        std::cerr << "Failed to register the io_uring socket with a poller." << std::endl;
+        return 1;
+    }
+
+    constexpr size_t packetCount = 300; // more than the provided buffer ring holds, so the receive must re-arm
+    uint8_t payloads[packetCount][8];
+    OutgoingPacket outgoing[packetCount];
+    for (size_t i = 0; i < packetCount; ++i) {
+        std::fill(std::begin(payloads[i]), std::end(payloads[i]), static_cast<uint8_t>(i));
+        outgoing[i] = OutgoingPacket{.addr = Endpoint{}, .data = payloads[i], .length = sizeof(payloads[i])};
+    }
+
+    auto sent = client->sendBatch(outgoing);
+    if (!sent || *sent != packetCount) {
+        std::cerr << "io_uring sendBatch accepted " << (sent ? *sent : 0) << " of " << packetCount << std::endl;
+        return 1;
+    }
+
+    size_t received = 0;
+    Endpoint clientEndpoint;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (received < packetCount && std::chrono::steady_clock::now() < deadline) {
+        if (!(*poller)->wait(100'000'000)) {
+            std::cerr << "Poller wait failed on the io_uring socket." << std::endl;
+            return 1;
+        }
+
+        ReceivedPacket batch[kMaxRecvBatch];
+        while (auto n = server->recvBatch(batch)) {
+            for (size_t i = 0; i < *n; ++i) {
+                if (batch[i].length != 8 || batch[i].data[0] != static_cast<uint8_t>(received)) {
+                    std::cerr << "io_uring datagram " << received << " arrived out of order or damaged." << std::endl;
+                    return 1;
+                }
+                clientEndpoint = batch[i].addr;
+                received++;
+            }
+        }
+    }
+
+    if (received != packetCount) {
+        std::cerr << "io_uring server received " << received << " of " << packetCount << " datagrams." << std::endl;
+        return 1;
+    }
+
+    // sendSegmented() rides the send ring too: ten 100-byte segments, via GSO where the kernel offers it
+    uint8_t segmented[1000];
+    for (size_t i = 0; i < sizeof(segmented); ++i) {
+        segmented[i] = static_cast<uint8_t>(i / 100);
+    }
+    auto segments = client->sendSegmented(Endpoint{}, segmented, sizeof(segmented), 100);
+    if (!segments || *segments != 10) {
+        std::cerr << "io_uring sendSegmented accepted " << (segments ? *segments : 0) << " of 10 segments." << std::endl;
+        return 1;
+    }
+    size_t segmentsReceived = 0;
+    while (segmentsReceived < 10 && std::chrono::steady_clock::now() < deadline + std::chrono::seconds(1)) {
+        if (!(*poller)->wait(100'000'000)) {
+            return 1;
+        }
+        while (auto packet = server->recvFrom()) {
+            if (packet->length != 100 || packet->data[0] != static_cast<uint8_t>(segmentsReceived)) {
+                std::cerr << "io_uring segment " << segmentsReceived << " arrived out of order or damaged." << std::endl;
+                return 1;
+            }
+            segmentsReceived++;
+        }
+    }
+    if (segmentsReceived != 10) {
+        std::cerr << "io_uring server received " << segmentsReceived << " of 10 segments." << std::endl;
+        return 1;
+    }
+
+    const uint8_t reply[] = {'o', 'k'};
+    if (!server->sendTo(clientEndpoint, reply, sizeof(reply))) {
+        std::cerr << "io_uring sendTo failed." << std::endl;
+        return 1;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    auto buffer = PacketBuffer::Create(64);
+    if (!buffer || !client->recvInto(*buffer) || buffer->size() != sizeof(reply) || buffer->data()[0] != 'o') {
+        std::cerr << "io_uring client did not receive the reply." << std::endl;
+        return 1;
+    }
+
+    server->close();
+    if (server->getHandle()) {
+        std::cerr << "Closed io_uring socket still reports a handle." << std::endl;
+        return 1;
+    }
+
+    // The port must be free again once the armed receive has been torn down
+    if (!Listen(serverAddr)) {
+        std::cerr << "Closing the io_uring socket did not release its port." << std::endl;
+        return 1;
+    }
+
+    std::cout << "io_uring backend exchanged " << packetCount << " datagrams." << std::endl;
+    return 0;
+}
+
+int testSocketOptions() {
+    using namespace pulse::net::udp;
+
+    std::cout << "Testing socket options..." << std::endl;
+    SocketConfig config;
+    config.recv_buffer_size = 4 * 1024 * 1024;
+    config.send_buffer_size = 1024 * 1024;
+    config.dscp = 46; // EF
+#if defined(__linux__)
+    config.priority = 3;
+    config.mtu_discovery = MtuDiscovery::Do;
+#endif
+
+    Addr addr("127.0.0.1", 12364);
+    auto server = Listen(addr, config);
+    auto client = Dial(addr, config);
+    if (!server || !client) {
+        std::cerr << "Listen/Dial with options failed." << std::endl;
+        return 1;
+    }
+
+    auto effective = (*server)->effectiveConfig();
+    if (!effective) {
+        std::cerr << "effectiveConfig failed: " << ErrorToString(effective.error()) << std::endl;
+        return 1;
+    }
+    if (effective->recv_buffer_size == 0 || effective->send_buffer_size == 0 || effective->dscp != 46) {
+        std::cerr << "Effective options do not reflect the request." << std::endl;
+        return 1;
+    }
+#if defined(__linux__)
+    if (effective->priority != 3 || effective->mtu_discovery != MtuDiscovery::Do) {
+        std::cerr << "Effective priority/MTU discovery do not reflect the request." << std::endl;
+        return 1;
+    }
+#endif
+    std::cout << "Requested 4 MiB receive buffer, kernel granted " << effective->recv_buffer_size << " bytes." << std::endl;
+
+    const uint8_t ping[] = {'o', 'p', 't'};
+    if (!(*client)->send(ping, sizeof(ping))) {
+        std::cerr << "Send on configured socket failed." << std::endl;
+        return 1;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    if (auto packet = (*server)->recvFrom(); !packet || packet->length != sizeof(ping)) {
+        std::cerr << "Receive on configured socket failed." << std::endl;
+        return 1;
+    }
+
+    SocketConfig invalid;
+    invalid.dscp = 64;
+    if (auto rejected = Listen(Addr("127.0.0.1", 12365), invalid); rejected || rejected.error() != ErrorCode::InvalidArgument) {
+        std::cerr << "An out-of-range DSCP should be rejected with InvalidArgument." << std::endl;
+        return 1;
+    }
+
+    // A rejected option must not leave the port bound
+    if (!Listen(Addr("127.0.0.1", 12365))) {
+        std::cerr << "Failed option application leaked the socket." << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+#if defined(__linux__)
+// Overflows a tiny receive queue, then checks every path reports kernel timestamps and the drop counter
+int checkRxMetadata(const pulse::net::udp::SocketConfig& config, uint16_t port, const char* label) {
+    using namespace pulse::net::udp;
+
+    Addr addr("127.0.0.1", port);
+    auto server = Listen(addr, config);
+    auto client = Dial(addr);
+    if (!server || !client) {
+        std::cerr << label << ": failed to open sockets." << std::endl;
+        return 1;
+    }
+
+    const auto before = std::chrono::system_clock::now();
+    uint8_t payload[1000] = {};
+    for (int i = 0; i < 200; ++i) {
+        (*client)->send(payload, sizeof(payload));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    const auto toNs = [](std::chrono::system_clock::time_point t) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count());
+    };
+
+    ReceivedPacket batch[kMaxRecvBatch];
+    auto first = (*server)->recvFrom();
+    auto rest = (*server)->recvBatch(batch);
+    if (!first || !rest || *rest == 0) {
+        std::cerr << label << ": nothing received." << std::endl;
+        return 1;
+    }
+    // Taken after the reads: loopback delivery can be deferred to a softirq that runs after the sleep
+    const auto after = std::chrono::system_clock::now();
+
+    for (size_t i = 0; i <= *rest; ++i) {
+        const ReceivedPacket& packet = (i == 0) ? *first : batch[i - 1];
+        if (packet.rx_timestamp_ns < toNs(before) || packet.rx_timestamp_ns > toNs(after)) {
+            std::cerr << label << ": receive timestamp " << packet.rx_timestamp_ns << " outside the send window." << std::endl;
+            return 1;
+        }
+    }
+
+    // The counter rides on datagrams queued after the overflow, so drain and send one more
+    while ((*server)->recvBatch(batch)) {
+    }
+    (*client)->send(payload, sizeof(payload));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    auto late = (*server)->recvFrom();
+    if (!late || late->drops == 0) {
+        std::cerr << label << ": overflowing the receive queue did not raise the drop counter." << std::endl;
+        return 1;
+    }
+
+    std::cout << label << ": queue dropped " << late->drops << " datagrams; timestamps in range." << std::endl;
+    return 0;
+}
+#endif
+
+int testRxMetadata() {
+    using namespace pulse::net::udp;
+
+    std::cout << "Testing receive timestamps and drop counters..." << std::endl;
+#if defined(__linux__)
+    SocketConfig config;
+    config.recv_buffer_size = 16 * 1024; // small enough for 200 KB of traffic to overflow
+    config.rx_timestamps = true;
+    config.rx_drop_counter = true;
+    if (checkRxMetadata(config, 12366, "syscall") != 0) {
+        return 1;
+    }
+
+    config.backend = SocketBackend::IoUring;
+    if (auto probe = Listen(Addr("127.0.0.1", 12367), config); !probe && probe.error() == ErrorCode::NotSupported) {
+        std::cout << "io_uring backend not supported here, skipping." << std::endl;
+        return 0;
+    }
+    if (checkRxMetadata(config, 12367, "io_uring") != 0) {
+        return 1;
+    }
+#else
+    SocketConfig config;
+    config.rx_timestamps = true;
+    if (auto rejected = Listen(Addr("127.0.0.1", 12366), config); rejected || rejected.error() != ErrorCode::NotSupported) {
+        std::cerr << "Receive timestamps should be NotSupported on this platform." << std::endl;
+        return 1;
+    }
+#endif
+    return 0;
+}
+
+int testMetrics() {
+    using namespace pulse::net::udp;
+
+    std::cout << "Testing socket metrics..." << std::endl;
+    Addr addr("127.0.0.1", 12368);
+    auto server = Listen(addr);
+    auto client = Dial(addr);
+    if (!server || !client) {
+        std::cerr << "Failed to open metrics test sockets." << std::endl;
+        return 1;
+    }
+
+#if defined(PULSENET_UDP_METRICS)
+    uint8_t payload[100] = {};
+    for (int i = 0; i < 10; ++i) {
+        (*client)->send(payload, sizeof(payload));
+    }
+    OutgoingPacket batch[5];
+    for (auto& packet : batch) {
+        packet = OutgoingPacket{.addr = Endpoint{}, .data = payload, .length = sizeof(payload)};
+    }
+    (*client)->sendBatch(batch);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    while ((*server)->recvFrom()) {
+    }
+
+    auto sent = (*client)->metrics();
+    auto received = (*server)->metrics();
+    if (!sent || !received) {
+        std::cerr << "metrics() failed in an instrumented build." << std::endl;
+        return 1;
+    }
+    if (sent->packets_sent != 15 || sent->bytes_sent != 1500 || sent->send_calls != 11) {
+        std::cerr << "Unexpected send counters: " << sent->packets_sent << " packets, " << sent->send_calls << " calls." << std::endl;
+        return 1;
+    }
+    if (received->packets_received != 15 || received->recvErrors(ErrorCode::WouldBlock) != 1) {
+        std::cerr << "Unexpected receive counters: " << received->packets_received << " packets." << std::endl;
+        return 1;
+    }
+    if (received->recv_latency.samples != 15 || received->recv_latency.percentile(0.5) == 0 ||
+        received->recv_latency.percentile(0.99) > received->recv_latency.max_ns) {
+        std::cerr << "Receive latency histogram is inconsistent." << std::endl;
+        return 1;
+    }
+    std::cout << "recvfrom p50 " << received->recv_latency.percentile(0.5) << " ns, max " << received->recv_latency.max_ns << " ns." << std::endl;
+#else
+    if (auto m = (*server)->metrics(); m || m.error() != ErrorCode::NotSupported) {
+        std::cerr << "metrics() should be NotSupported when compiled out." << std::endl;
+        return 1;
+    }
+#endif
+    return 0;
+}
+
+// Sends one datagram of `size` bytes and reads it back with recvFrom(), retrying briefly for the io_uring backend
+std::expected<pulse::net::udp::ReceivedPacket, pulse::net::udp::ErrorCode> echoDatagram(pulse::net::udp::Socket& client, pulse::net::udp::Socket& server,
+                                                                                      const std::vector<uint8_t>& payload) {
+    using namespace pulse::net::udp;
+
+    if (auto sent = client.send(payload.data(), payload.size()); !sent) {
+        return std::unexpected(sent.error());
+    }
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        auto packet = server.recvFrom();
+        if (packet || packet.error() != ErrorCode::WouldBlock) {
+            return packet;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return std::unexpected(ErrorCode::Timeout);
+}
+
+// Oversized datagrams must come back flagged with their true size, and a jumbo max_datagram_size must deliver them whole
+int checkTruncation(pulse::net::udp::SocketBackend backend, uint16_t port, const char* label) {
+    using namespace pulse::net::udp;
+
+    Addr addr("127.0.0.1", port);
+    SocketConfig config{.backend = backend, .recv_buffer_size = 1024 * 1024};
+    auto server = Listen(addr, config);
+    auto client = Dial(addr);
+    if (!server || !client) {
+        std::cerr << label << ": failed to open sockets." << std::endl;
+        return 1;
+    }
+
+    std::vector<uint8_t> small(100, 0x11);
+    std::vector<uint8_t> large(4000);
+    for (size_t i = 0; i < large.size(); ++i) {
+        large[i] = static_cast<uint8_t>(i * 13);
+    }
+
+    auto whole = echoDatagram(**client, **server, small);
+    if (!whole || whole->truncated || whole->length != small.size() || whole->datagram_length != small.size()) {
+        std::cerr << label << ": a small datagram was reported truncated or mis-sized." << std::endl;
+        return 1;
+    }
+
+    auto cut = echoDatagram(**client, **server, large);
+    if (!cut || !cut->truncated || cut->length != kDefaultMaxDatagramSize ||
+        !std::equal(cut->data, cut->data + cut->length, large.begin())) {
+        std::cerr << label << ": a datagram over max_datagram_size was not reported truncated." << std::endl;
+        return 1;
+    }
+#if defined(__linux__)
+    if (cut->datagram_length != large.size()) {
+        std::cerr << label << ": truncated datagram reported " << cut->datagram_length << " bytes instead of its true size." << std::endl;
+        return 1;
+    }
+#endif
+
+    // A caller buffer smaller than the datagram is flagged the same way, as is an undersized PacketBuffer
+    if (auto sent = (*client)->send(small.data(), small.size()); !sent) {
+        std::cerr << label << ": send failed." << std::endl;
+        return 1;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    uint8_t tiny[10];
+    auto clipped = (*server)->recvFrom(std::span(tiny));
+    if (!clipped || !clipped->truncated || clipped->length != sizeof(tiny)) {
+        std::cerr << label << ": recvFrom(span) did not flag a datagram larger than the caller's buffer." << std::endl;
+        return 1;
+    }
+
+    auto packet = PacketBuffer::Create(1000);
+    if (!packet || !(*client)->send(large.data(), large.size())) {
+        std::cerr << label << ": PacketBuffer setup failed." << std::endl;
+        return 1;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    if (auto received = (*server)->recvInto(*packet); !received || !packet->truncated() || packet->size() != 1000) {
+        std::cerr << label << ": recvInto did not flag a datagram larger than the PacketBuffer." << std::endl;
+        return 1;
+    }
+
+    (*server)->close();
+
+    // Jumbo configuration: 60 KB datagrams arrive intact through recvFrom() and recvBatch()
+    config.max_datagram_size = kMaxDatagramSize;
+    auto jumboServer = Listen(addr, config);
+    if (!jumboServer) {
+        std::cerr << label << ": failed to open jumbo socket: " << ErrorToString(jumboServer.error()) << std::endl;
+        return 1;
+    }
+
+    std::vector<uint8_t> jumbo(60000);
+    for (size_t i = 0; i < jumbo.size(); ++i) {
+        jumbo[i] = static_cast<uint8_t>(i * 31);
+    }
+    auto big = echoDatagram(**client, **jumboServer, jumbo);
+    if (!big || big->truncated || big->length != jumbo.size() || !std::equal(jumbo.begin(), jumbo.end(), big->data)) {
+        std::cerr << label << ": jumbo datagram did not arrive whole through recvFrom()." << std::endl;
+        return 1;
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        (*client)->send(jumbo.data(), jumbo.size());
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ReceivedPacket batch[kMaxRecvBatch];
+    auto n = (*jumboServer)->recvBatch(batch);
+    if (!n || *n != 3) {
+        std::cerr << label << ": recvBatch returned " << (n ? *n : 0) << " jumbo datagrams instead of 3." << std::endl;
+        return 1;
+    }
+    for (size_t i = 0; i < *n; ++i) {
+        if (batch[i].truncated || batch[i].length != jumbo.size() || !std::equal(jumbo.begin(), jumbo.end(), batch[i].data)) {
+            std::cerr << label << ": jumbo datagram " << i << " did not arrive whole through recvBatch()." << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << label << ": truncation reported, jumbo datagrams delivered whole." << std::endl;
+    return 0;
+}
+
+int testTruncation() {
+    using namespace pulse::net::udp;
+
+    std::cout << "Testing truncation reporting and jumbo datagrams..." << std::endl;
+    for (size_t invalid : {size_t{0}, kMaxDatagramSize + 1}) {
+        if (auto rejected = Listen(Addr("127.0.0.1", 12369), SocketConfig{.max_datagram_size = invalid});
+            rejected || rejected.error() != ErrorCode::InvalidArgument) {
+            std::cerr << "max_datagram_size " << invalid << " should be rejected with InvalidArgument." << std::endl;
+            return 1;
+        }
+    }
+
+    if (checkTruncation(SocketBackend::Syscall, 12369, "syscall") != 0) {
+        return 1;
+    }
+
+    if (auto probe = Listen(Addr("127.0.0.1", 12370), SocketConfig{.backend = SocketBackend::IoUring});
+        !probe && probe.error() == ErrorCode::NotSupported) {
+        std::cout << "io_uring backend not supported here, skipping." << std::endl;
+        return 0;
+    }
+    return checkTruncation(SocketBackend::IoUring, 12370, "io_uring");
+}
+
+int testPeerSession() {
+    using namespace pulse::net::udp;
+
+    std::cout << "Testing peer sessions..." << std::endl;
+    Addr addr("127.0.0.1", 12371);
+    SocketConfig listenerConfig;
+#if defined(__linux__)
+    listenerConfig.reuse_port = true; // lets connected sessions share the port
+#endif
+    auto listener = Listen(addr, listenerConfig);
+    auto first = Dial(addr);
+    auto second = Dial(addr);
+    if (!listener || !first || !second) {
+        std::cerr << "Failed to open peer session sockets." << std::endl;
+        return 1;
+    }
+    auto firstPeer = (*first)->localEndpoint();
+    auto secondPeer = (*second)->localEndpoint();
+    if (!firstPeer || !secondPeer || firstPeer->port() == 0 || !firstPeer->isV4()) {
+        std::cerr << "localEndpoint() did not report the dialled sockets' addresses." << std::endl;
+        return 1;
+    }
+
+    if (auto invalid = PeerSession::Open(**listener, Endpoint{}); invalid || invalid.error() != ErrorCode::InvalidAddress) {
+        std::cerr << "Opening a session to an unspecified peer should fail with InvalidAddress." << std::endl;
+        return 1;
+    }
+
+    // Unconnected: sends go through the listener with the pre-encoded destination
+    auto shared = PeerSession::Open(**listener, *firstPeer);
+    if (!shared || shared->connected() || shared->socket() != nullptr || shared->discarded() != 0) {
+        std::cerr << "Failed to open an unconnected peer session." << std::endl;
+        return 1;
+    }
+    const uint8_t hello[] = {'h', 'i'};
+    if (!shared->send(hello, sizeof(hello))) {
+        std::cerr << "Unconnected session send failed." << std::endl;
+        return 1;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    if (auto reply = (*first)->recvFrom(); !reply || reply->length != sizeof(hello) || reply->addr.port() != 12371) {
+        std::cerr << "Peer did not receive the unconnected session's datagram." << std::endl;
+        return 1;
+    }
+
+#if defined(__linux__)
+    auto connected = PeerSession::Open(**listener, *secondPeer, PeerSessionConfig{.connected = true, .socket = {}});
+    // Nothing else is sending, so opening the session had no strays to throw away
+    if (!connected || !connected->connected() || connected->socket() == nullptr || connected->discarded() != 0) {
+        std::cerr << "Failed to open a connected peer session: " << (connected ? "no socket" : ErrorToString(connected.error())) << std::endl;
+        return 1;
+    }
+
+    OutgoingPacket batch[3];
+    for (auto& packet : batch) {
+        packet = OutgoingPacket{.addr = Endpoint{}, .data = hello, .length = sizeof(hello)};
+    }
+    if (auto sent = connected->sendBatch(batch); !sent || *sent != 3) {
+        std::cerr << "Connected session sendBatch failed." << std::endl;
+        return 1;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    ReceivedPacket received[kMaxRecvBatch];
+    if (auto n = (*second)->recvBatch(received); !n || *n != 3 || received[0].addr.port() != 12371) {
+        std::cerr << "Peer did not receive the connected session's datagrams from the shared port." << std::endl;
+        return 1;
+    }
+
+    // Demultiplexing: the connected peer's traffic lands on the session socket, everyone else's on the listener
+    for (int i = 0; i < 20; ++i) {
+        (*first)->send(hello, sizeof(hello));
+        (*second)->send(hello, sizeof(hello));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    size_t onSession = 0;
+    while (auto packet = connected->socket()->recvFrom()) {
+        if (!(packet->addr == *secondPeer)) {
+            std::cerr << "Session socket received a datagram from another peer." << std::endl;
+            return 1;
+        }
+        onSession++;
+    }
+    size_t onListener = 0;
+    while (auto packet = (*listener)->recvFrom()) {
+        if (!(packet->addr == *firstPeer)) {
+            std::cerr << "Listener received a datagram from the connected session's peer." << std::endl;
+            return 1;
+        }
+        onListener++;
+    }
+    if (onSession != 20 || onListener != 20) {
+        std::cerr << "Expected 20 datagrams each on the session and the listener, got " << onSession << " and " << onListener << "." << std::endl;
+        return 1;
+    }
+
+    // Without reuse_port on the listener the session socket cannot share its port
+    auto exclusive = Listen(Addr("127.0.0.1", 12372));
+    if (!exclusive) {
+        std::cerr << "Failed to open exclusive listener." << std::endl;
+        return 1;
+    }
+    if (auto refused = PeerSession::Open(**exclusive, *secondPeer, PeerSessionConfig{.connected = true, .socket = {}});
+        refused || refused.error() != ErrorCode::BindFailed) {
+        std::cerr << "A connected session on a listener without reuse_port should fail with BindFailed." << std::endl;
+        return 1;
+    }
+    std::cout << "Connected session demultiplexed " << onSession << " datagrams from its peer." << std::endl;
+#else
+    if (auto refused = PeerSession::Open(**listener, *secondPeer, PeerSessionConfig{.connected = true, .socket = {}});
+        refused || refused.error() != ErrorCode::NotSupported) {
+        std::cerr << "Connected peer sessions should be NotSupported on this platform." << std::endl;
+        return 1;
+    }
+#endif
+    return 0;
+}
+
+int testSessionTable() {
+    using namespace pulse::net::udp;
+
+    std::cout << "Testing the session table..." << std::endl;
+    if (SessionTable::Create(0, 0)) {
+        std::cerr << "SessionTable::Create should reject a zero capacity." << std::endl;
+        return 1;
+    }
+
+    const uint64_t idle = 1'000;
+    auto created = SessionTable::Create(4, idle);
+    if (!created) {
+        std::cerr << "SessionTable::Create failed." << std::endl;
+        return 1;
+    }
+    SessionTable table = std::move(*created);
+
+    const auto peerAt = [](uint16_t port) { return Endpoint::FromAddr(Addr("10.0.0.1", port)); };
+    SessionHandle handles[4];
+    for (uint16_t i = 0; i < 4; ++i) {
+        auto lookup = table.touch(peerAt(1000 + i), i);
+        if (!lookup || !lookup->created) {
+            std::cerr << "Opening session " << i << " failed." << std::endl;
+            return 1;
+        }
+        handles[i] = lookup->handle;
+    }
+    if (auto full = table.touch(peerAt(2000), 5); full || full.error() != ErrorCode::PoolExhausted) {
+        std::cerr << "A full table should refuse new sessions with PoolExhausted." << std::endl;
+        return 1;
+    }
+    if (auto again = table.touch(peerAt(1000), 10); !again || again->created || !(again->handle == handles[0])) {
+        std::cerr << "Touching a known peer should return its existing handle." << std::endl;
+        return 1;
+    }
+
+    // Peer 1000 was refreshed at t=10, so at t=1003 only 1001..1003 (last seen at 1..3) have been idle for 1000 ns
+    SessionHandle evicted[8];
+    const size_t count = table.evictIdle(1'003, evicted);
+    if (count != 3 || !(evicted[0] == handles[1]) || !(evicted[2] == handles[3]) || table.size() != 1 ||
+        table.contains(handles[1]) || table.peer(handles[1]) != nullptr || !table.contains(handles[0])) {
+        std::cerr << "evictIdle() should close exactly the idle sessions, oldest first; closed " << count << "." << std::endl;
+        return 1;
+    }
+
+    // A freed slot comes back under a new generation, so the old handle stays stale
+    auto reused = table.touch(peerAt(3000), 1'100);
+    if (!reused || !reused->created || table.contains(handles[3]) || table.find(peerAt(1003)).has_value() ||
+        table.peer(reused->handle) == nullptr || !(*table.peer(reused->handle) == peerAt(3000))) {
+        std::cerr << "Reused session slots must not revive stale handles." << std::endl;
+        return 1;
+    }
+    if (!table.remove(handles[0]) || table.remove(handles[0]) || table.find(peerAt(1000)).has_value()) {
+        std::cerr << "remove() should close a session exactly once." << std::endl;
+        return 1;
+    }
+
+    // Churn 400 possible peers through 512 slots against a reference map, exercising probing and backward-shift deletion
+    auto bigCreated = SessionTable::Create(512, 0);
+    if (!bigCreated) {
+        return 1;
+    }
+    SessionTable big = std::move(*bigCreated);
+    std::unordered_map<Endpoint, SessionHandle> reference;
+    uint32_t seed = 12345;
+    for (int step = 0; step < 20000; ++step) {
+        seed = seed * 1664525 + 1013904223;
+        const Endpoint peer = Endpoint::FromAddr(Addr("192.168.0." + std::to_string((seed >> 8) % 4), static_cast<uint16_t>(1 + (seed >> 16) % 100)));
+        auto known = reference.find(peer);
+        if ((seed >> 4) % 3 == 0 && known != reference.end()) {
+            if (!big.remove(known->second)) {
+                std::cerr << "Session table lost a live session during churn." << std::endl;
+                return 1;
+            }
+            reference.erase(known);
+            continue;
+        }
+        auto lookup = big.touch(peer, static_cast<uint64_t>(step));
+        if (!lookup || lookup->created != (known == reference.end()) || (known != reference.end() && !(known->second == lookup->handle))) {
+            std::cerr << "Session table disagrees with the reference map at step " << step << "." << std::endl;
+            return 1;
+        }
+        reference[peer] = lookup->handle;
+    }
+    for (const auto& [peer, handle] : reference) {
+        if (auto found = big.find(peer); !found || !(*found == handle)) {
+            std::cerr << "Session table lost " << peer.toString() << " after churn." << std::endl;
+            return 1;
+        }
+    }
+    if (big.size() != reference.size()) {
+        std::cerr << "Session table size " << big.size() << " does not match the reference " << reference.size() << "." << std::endl;
+        return 1;
+    }
+
+    std::cout << "Session table tracked " << reference.size() << " sessions through churn." << std::endl;
+    return 0;
+}
+
+// Forwards sends to a real socket but takes only `budget` datagrams, then reports WouldBlock like a full buffer
+class ThrottledSocket : public pulse::net::udp::Socket {
+public:
+    using ErrorCode = pulse::net::udp::ErrorCode;
+    using Endpoint = pulse::net::udp::Endpoint;
+
+    explicit ThrottledSocket(pulse::net::udp::Socket& inner) : inner_(inner) {}
+
+    size_t budget = 0;
+
+    std::expected<void, ErrorCode> sendTo(const pulse::net::udp::Addr& addr, const uint8_t* data, size_t length) override {
+        return take(1) ? inner_.sendTo(addr, data, length) : std::unexpected(ErrorCode::WouldBlock);
+    }
+    std::expected<void, ErrorCode> sendTo(const Endpoint& addr, const uint8_t* data, size_t length) override {
+        return take(1) ? inner_.sendTo(addr, data, length) : std::unexpected(ErrorCode::WouldBlock);
+    }
+    std::expected<void, ErrorCode> send(const uint8_t* data, size_t length) override {
+        return take(1) ? inner_.send(data, length) : std::unexpected(ErrorCode::WouldBlock);
+    }
+    std::expected<size_t, ErrorCode> sendBatch(std::span<const pulse::net::udp::OutgoingPacket> packets) override {
+        const size_t allowed = std::min(budget, packets.size());
+        if (allowed == 0) {
+            return std::unexpected(ErrorCode::WouldBlock);
+        }
+        auto sent = inner_.sendBatch(packets.first(allowed));
+        if (sent) {
+            budget -= *sent;
+        }
+        return sent;
+    }
+    std::expected<size_t, ErrorCode> sendSegmented(const Endpoint& addr, const uint8_t* data, size_t length, size_t segmentSize) override {
+        const size_t allowed = std::min(budget, (length + segmentSize - 1) / segmentSize);
+        if (allowed == 0) {
+            return std::unexpected(ErrorCode::WouldBlock);
+        }
+        auto sent = inner_.sendSegmented(addr, data, std::min(length, allowed * segmentSize), segmentSize);
+        if (sent) {
+            budget -= *sent;
+        }
+        return sent;
+    }
+    std::expected<pulse::net::udp::ReceivedPacket, ErrorCode> recvFrom() override { return inner_.recvFrom(); }
+    std::expected<pulse::net::udp::ReceivedPacket, ErrorCode> recvFrom(std::span<uint8_t> buffer) override { return inner_.recvFrom(buffer); }
+    std::expected<void, ErrorCode> recvInto(pulse::net::udp::PacketBuffer& packet) override { return inner_.recvInto(packet); }
+    std::expected<size_t, ErrorCode> recvBatch(std::span<pulse::net::udp::ReceivedPacket> packets) override { return inner_.recvBatch(packets); }
+    std::expected<void, ErrorCode> enableGro() override { return inner_.enableGro(); }
+    std::expected<pulse::net::udp::CoalescedPacket, ErrorCode> recvCoalesced() override { return inner_.recvCoalesced(); }
+    std::expected<pulse::net::udp::SocketMetrics, ErrorCode> metrics() const override { return inner_.metrics(); }
+    std::expected<pulse::net::udp::SocketConfig, ErrorCode> effectiveConfig() const override { return inner_.effectiveConfig(); }
+    std::expected<Endpoint, ErrorCode> localEndpoint() const override { return inner_.localEndpoint(); }
+    std::expected<int, ErrorCode> getHandle() const override { return inner_.getHandle(); }
+    void close() override { inner_.close(); }
+
+private:
+    bool take(size_t count) {
+        if (budget < count) {
+            return false;
+        }
+        budget -= count;
+        return true;
+    }
+
+    pulse::net::udp::Socket& inner_;
+};
+
+int testSendQueue() {
+    using namespace pulse::net::udp;
+
+    std::cout << "Testing the send queue..." << std::endl;
+    auto sender = Listen(Addr("127.0.0.1", 12374));
+    auto receiver = Listen(Addr("127.0.0.1", 12375));
+    if (!sender || !receiver) {
+        std::cerr << "Failed to open send queue sockets." << std::endl;
+        return 1;
+    }
+    if (SendQueue::Create(**sender, SendQueueConfig{.max_datagrams = 0})) {
+        std::cerr << "SendQueue::Create should reject a zero datagram limit." << std::endl;
+        return 1;
+    }
+
+    ThrottledSocket throttled(**sender);
+    auto created = SendQueue::Create(throttled, SendQueueConfig{.max_datagrams = 8, .max_bytes = 1024});
+    if (!created) {
+        std::cerr << "SendQueue::Create failed." << std::endl;
+        return 1;
+    }
+    SendQueue queue = std::move(*created);
+
+    // Four datagrams forming one GSO run (100, 100, 100, 60 bytes), then two that do not, each filled with its index
+    const Endpoint to = Endpoint::FromAddr(Addr("127.0.0.1", 12375));
+    const size_t sizes[] = {100, 100, 100, 60, 30, 40};
+    for (size_t i = 0; i < std::size(sizes); ++i) {
+        std::vector<uint8_t> payload(sizes[i], static_cast<uint8_t>(i));
+        if (!queue.push(to, payload.data(), payload.size())) {
+            std::cerr << "Queueing datagram " << i << " failed." << std::endl;
+            return 1;
+        }
+    }
+    std::vector<uint8_t> oversized(1024);
+    if (auto full = queue.push(to, oversized.data(), oversized.size()); full || full.error() != ErrorCode::PoolExhausted) {
+        std::cerr << "push() past max_bytes should fail with PoolExhausted." << std::endl;
+        return 1;
+    }
+
+    // The socket takes two datagrams and then reports a full buffer: the rest must stay queued, in order
+    throttled.budget = 2;
+    auto first = queue.flush();
+    if (!first || *first != 2 || queue.pending() != 4 || queue.pendingBytes() != 230 || queue.stats().deferred != 1) {
+        std::cerr << "flush() should keep what a full socket refused; pending " << queue.pending() << "." << std::endl;
+        return 1;
+    }
+    throttled.budget = 100;
+    auto second = queue.flush();
+    if (!second || *second != 4 || !queue.empty() || queue.stats().sent != 6 || queue.stats().segmented != 4) {
+        std::cerr << "A second flush() should drain the queue, segmenting the same-size run." << std::endl;
+        return 1;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    for (size_t i = 0; i < std::size(sizes); ++i) {
+        auto packet = (*receiver)->recvFrom();
+        if (!packet || packet->length != sizes[i] ||
+            !std::all_of(packet->data, packet->data + packet->length, [i](uint8_t b) { return b == i; })) {
+            std::cerr << "Datagram " << i << " arrived wrong or out of order." << std::endl;
+            return 1;
+        }
+    }
+
+    // An unusable socket fails the flush without losing anything
+    const uint8_t payload[] = {1, 2, 3};
+    if (!queue.push(to, payload, sizeof(payload)) || !queue.push(to, payload, sizeof(payload))) {
+        return 1;
+    }
+    (*sender)->close();
+    if (auto closed = queue.flush(); closed || closed.error() != ErrorCode::InvalidSocket || queue.pending() != 2) {
+        std::cerr << "flush() on a closed socket should fail with InvalidSocket and keep the queue." << std::endl;
+        return 1;
+    }
+
+    std::cout << "Send queue retained and flushed " << queue.stats().sent << " datagrams in order." << std::endl;
+    return 0;
+}
+
+int testPacketRing() {
+    using namespace pulse::net::udp;
+
+    std::cout << "Testing packet rings..." << std::endl;
+    if (PacketRing::Create(0)) {
+        std::cerr << "PacketRing::Create should reject a zero capacity." << std::endl;
+        return 1;
+    }
+
+    // Single producer: FIFO order, refusal when full without consuming the packet
+    auto spscResult = PacketRing::Create(3);
+    if (!spscResult || (*spscResult)->capacity() != 4) {
+        std::cerr << "PacketRing::Create should round the capacity up to a power of two." << std::endl;
+        return 1;
+    }
+    auto& spsc = *spscResult;
+    for (uint8_t i = 0; i < 5; ++i) {
+        auto buffer = PacketBuffer::Create(16);
+        if (!buffer || !buffer->resize(1)) {
+            return 1;
+        }
+        buffer->data()[0] = i;
+        const bool pushed = spsc->tryPush(*buffer);
+        if (pushed != (i < 4) || pushed == static_cast<bool>(*buffer)) {
+            std::cerr << "Push " << int(i) << " into a 4-slot ring " << (pushed ? "succeeded" : "failed") << " unexpectedly." << std::endl;
+            return 1;
+        }
+    }
+    PacketBuffer popped[8];
+    if (!spsc->full() || spsc->popBatch(popped) != 4 || spsc->size() != 0 || spsc->tryPop(popped[4])) {
+        std::cerr << "popBatch() should drain a full ring." << std::endl;
+        return 1;
+    }
+    for (uint8_t i = 0; i < 4; ++i) {
+        if (popped[i].size() != 1 || popped[i].data()[0] != i) {
+            std::cerr << "Ring popped packet " << int(i) << " out of order." << std::endl;
+            return 1;
+        }
+    }
+    auto spscStats = spsc->stats();
+    if (spscStats.pushed != 4 || spscStats.popped != 4 || spscStats.rejected != 1 || spscStats.high_water != 4) {
+        std::cerr << "Ring stats: pushed=" << spscStats.pushed << " rejected=" << spscStats.rejected
+                  << " high_water=" << spscStats.high_water << std::endl;
+        return 1;
+    }
+
+    // Multiple producers sharing one pool; each producer's packets must come out in its own order
+    auto poolResult = PacketPool::Create(PacketPoolConfig{.mtu_buffers = 256, .jumbo_buffers = 1});
+    auto mpscResult = PacketRing::Create(64, RingProducers::Multiple);
+    if (!poolResult || !mpscResult) {
+        return 1;
+    }
+    auto& pool = *poolResult;
+    auto& mpsc = *mpscResult;
+    constexpr uint32_t kProducers = 4;
+    constexpr uint32_t kPerProducer = 20000;
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (uint32_t seq = 0; seq < kPerProducer;) {
+                auto buffer = pool->acquire();
+                if (!buffer) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                const uint32_t tag[2] = {p, seq};
+                std::memcpy(buffer->data(), tag, sizeof(tag));
+                (void)buffer->resize(sizeof(tag));
+                while (!mpsc->tryPush(*buffer)) {
+                    std::this_thread::yield();
+                }
+                seq++;
+            }
+        });
+    }
+    uint32_t expected[kProducers] = {};
+    uint32_t received = 0;
+    bool ordered = true;
+    while (received < kProducers * kPerProducer) {
+        const size_t count = mpsc->popBatch(popped);
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t tag[2];
+            std::memcpy(tag, popped[i].data(), sizeof(tag));
+            ordered = ordered && tag[0] < kProducers && tag[1] == expected[tag[0]];
+            expected[tag[0]] = tag[1] + 1;
+            popped[i] = PacketBuffer{};
+        }
+        received += static_cast<uint32_t>(count);
+        if (count == 0) {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    if (!ordered || mpsc->stats().popped != kProducers * kPerProducer) {
+        std::cerr << "Multi-producer ring lost or reordered packets." << std::endl;
+        return 1;
+    }
+
+    // Pumps: socket -> ring on receive, ring -> socket on send
+    Addr serverAddr("127.0.0.1", 12376);
+    auto server = Listen(serverAddr);
+    auto client = Dial(serverAddr);
+    auto inboundResult = PacketRing::Create(4);
+    if (!server || !client || !inboundResult) {
+        return 1;
+    }
+    auto& inbound = *inboundResult;
+    const uint8_t payload[] = {9, 8, 7};
+    for (int i = 0; i < 6; ++i) {
+        if (!(*client)->send(payload, sizeof(payload))) {
+            return 1;
+        }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    // Only four fit; the other two must wait in the socket buffer rather than be dropped
+    auto pumped = PumpReceive(**server, *pool, *inbound);
+    if (!pumped || pumped->moved != 4 || pumped->dropped != 0 || inbound->popBatch(popped) != 4) {
+        std::cerr << "PumpReceive should stop at the ring's capacity." << std::endl;
+        return 1;
+    }
+    pumped = PumpReceive(**server, *pool, *inbound);
+    if (!pumped || pumped->moved != 2 || pumped->dropped != 0 || inbound->popBatch(std::span(popped + 4, 4)) != 2) {
+        std::cerr << "PumpReceive lost datagrams held back by backpressure." << std::endl;
+        return 1;
+    }
+
+    // Echo all six back through a reply ring, the way workers would
+    for (int i = 0; i < 6; ++i) {
+        if (!mpsc->tryPush(popped[i])) {
+            return 1;
+        }
+    }
+    auto sent = PumpSend(*mpsc, **server);
+    if (!sent || sent->moved != 6 || sent->dropped != 0 || mpsc->size() != 0) {
+        std::cerr << "PumpSend did not drain the reply ring." << std::endl;
+        return 1;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    ReceivedPacket echoes[kMaxRecvBatch];
+    auto echoed = (*client)->recvBatch(echoes);
+    if (!echoed || *echoed != 6 || !std::equal(payload, payload + sizeof(payload), echoes[5].data)) {
+        std::cerr << "Client did not receive the pumped echoes." << std::endl;
+        return 1;
+    }
+
+    // A packet the kernel rejects (port 0 is no destination) is dropped and reported, not retried forever
+    auto clientEndpoint = (*client)->localEndpoint();
+    auto rejected = pool->acquire();
+    auto accepted = pool->acquire();
+    if (!clientEndpoint || !rejected || !accepted || !rejected->resize(sizeof(payload)) || !accepted->resize(sizeof(payload))) {
+        return 1;
+    }
+    std::memcpy(accepted->data(), payload, sizeof(payload));
+    rejected->setAddr(Endpoint::FromAddr(Addr("127.0.0.1", 0)));
+    accepted->setAddr(*clientEndpoint);
+    if (!mpsc->tryPush(*rejected) || !mpsc->tryPush(*accepted)) {
+        return 1;
+    }
+    sent = PumpSend(*mpsc, **server);
+    if (!sent || sent->moved != 1 || sent->dropped != 1 || mpsc->size() != 0) {
+        std::cerr << "PumpSend should drop the rejected packet, report it, and send the one behind it." << std::endl;
+        return 1;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    if (auto echo = (*client)->recvFrom(); !echo || echo->length != sizeof(payload)) {
+        std::cerr << "Client did not receive the packet queued behind the rejected one." << std::endl;
+        return 1;
+    }
+
+    std::cout << "Packet rings moved " << received << " packets across threads and pumped 6 echoes." << std::endl;
+    return 0;
+}
+
+int testReceiveDriver() {
+    using namespace pulse::net::udp;
+
+    std::cout << "Testing the adaptive receive driver..." << std::endl;
+    Addr serverAddr("127.0.0.1", 12377);
+    auto server = Listen(serverAddr);
+    auto client = Dial(serverAddr);
+    if (!server || !client) {
+        std::cerr << "Failed to open receive driver sockets." << std::endl;
+        return 1;
+    }
+    if (ReceiveDriver::Create(**server, ReceiveDriverConfig{.max_spin_ns = 10, .min_spin_ns = 20})) {
+        std::cerr << "ReceiveDriver::Create should reject min_spin_ns above max_spin_ns." << std::endl;
+        return 1;
+    }
+
+    const ReceiveDriverConfig config{.max_spin_ns = 20'000};
+    auto created = ReceiveDriver::Create(**server, config);
+    if (!created) {
+        std::cerr << "ReceiveDriver::Create failed: " << ErrorToString(created.error()) << std::endl;
+        return 1;
+    }
+    ReceiveDriver driver = std::move(*created);
+
+    const auto before = std::chrono::steady_clock::now();
+    if (auto idle = driver.next(2'000'000); idle || idle.error() != ErrorCode::Timeout ||
+        std::chrono::steady_clock::now() - before < std::chrono::milliseconds(2)) {
+        std::cerr << "An idle driver should wait out its timeout and report Timeout." << std::endl;
+        return 1;
+    }
+
+    // A datagram sent while the driver is parked must wake it
+    std::thread late([&client] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        const uint8_t ping[] = {0xAA};
+        (void)(*client)->send(ping, sizeof(ping));
+    });
+    auto woken = driver.next();
+    late.join();
+    if (!woken || woken->length != 1 || woken->data[0] != 0xAA || driver.stats().parked < 2) {
+        std::cerr << "A parked driver did not wake for an arriving datagram." << std::endl;
+        return 1;
+    }
+
+    // A burst arrives back to back: the driver drains it in order and the budget stays within the cap
+    for (uint8_t i = 0; i < 32; ++i) {
+        if (!(*client)->send(&i, 1)) {
+            return 1;
+        }
+    }
+    for (uint8_t i = 0; i < 32; ++i) {
+        auto packet = driver.next(1'000'000'000);
+        if (!packet || packet->length != 1 || packet->data[0] != i) {
+            std::cerr << "Burst datagram " << int(i) << " missing or out of order." << std::endl;
+            return 1;
+        }
+    }
+    ReceivedPacket batch[kMaxRecvBatch];
+    const uint8_t tail[] = {1, 2};
+    if (!(*client)->send(tail, sizeof(tail)) || driver.nextBatch(batch, 1'000'000'000) != 1u) {
+        std::cerr << "nextBatch() did not return the pending datagram." << std::endl;
+        return 1;
+    }
+
+    const auto stats = driver.stats();
+    if (stats.received != 34 || stats.spin_budget_ns > config.max_spin_ns || stats.avg_gap_ns > 2 * config.max_spin_ns) {
+        std::cerr << "Driver stats: received=" << stats.received << " budget=" << stats.spin_budget_ns
+                  << " avg_gap=" << stats.avg_gap_ns << std::endl;
+        return 1;
+    }
+
+    std::cout << "Receive driver parked " << stats.parked << " times, spin budget " << stats.spin_budget_ns
+              << " ns after " << stats.received << " datagrams." << std::endl;
+    return 0;
+}
+
+pulse::net::udp::Task<void> echoServer(pulse::net::udp::AsyncSocket& server, int* echoed) {
+    using namespace pulse::net::udp;
+    while (true) {
+        // The clients finish well inside this; a quiet socket means the test is over
+        auto packet = co_await server.recv(200'000'000);
+        if (!packet) {
+            co_return;
+        }
+        if (co_await server.sendTo(packet->addr, packet->data, packet->length)) {
+            (*echoed)++;
+        }
+    }
+}
+
+pulse::net::udp::Task<bool> roundTrip(pulse::net::udp::AsyncSocket& client, uint32_t value) {
+    uint8_t request[sizeof(value)];
+    std::memcpy(request, &value, sizeof(value));
+    if (!co_await client.send(request, sizeof(request))) {
+        co_return false;
+    }
+    auto reply = co_await client.recv(1'000'000'000);
+    co_return reply && reply->length == sizeof(request) && std::equal(request, request + sizeof(request), reply->data);
+}
+
+pulse::net::udp::Task<void> echoClient(pulse::net::udp::Reactor& reactor, pulse::net::udp::Addr serverAddr, uint32_t id, int* completed) {
+    using namespace pulse::net::udp;
+    auto socket = Dial(serverAddr);
+    if (!socket) {
+        co_return;
+    }
+    auto client = AsyncSocket::Attach(reactor, **socket);
+    if (!client) {
+        co_return;
+    }
+    for (uint32_t round = 0; round < 3; ++round) {
+        if (!co_await roundTrip(*client, id * 10 + round)) {
+            co_return;
+        }
+        co_await reactor.sleepFor(1'000'000);
+    }
+    (*completed)++;
+}
+
+pulse::net::udp::Task<void> recvWithTimeout(pulse::net::udp::AsyncSocket& socket, uint64_t timeoutNs, pulse::net::udp::ErrorCode* outcome) {
+    auto packet = co_await socket.recv(timeoutNs);
+    *outcome = packet ? pulse::net::udp::ErrorCode::None : packet.error();
+}
+
+pulse::net::udp::Task<void> sleepThenRecv(pulse::net::udp::Reactor& reactor, pulse::net::udp::AsyncSocket& socket,
+                                          pulse::net::udp::ErrorCode* outcome) {
+    co_await reactor.sleepFor(20'000'000);
+    auto packet = co_await socket.recv(100'000'000);
+    *outcome = packet ? pulse::net::udp::ErrorCode::None : packet.error();
+}
+
+int testReactor() {
+    using namespace pulse::net::udp;
+
+    std::cout << "Testing the coroutine reactor..." << std::endl;
+    auto reactorResult = Reactor::Create();
+    Addr serverAddr("127.0.0.1", 12378);
+    auto serverSocket = Listen(serverAddr);
+    if (!reactorResult || !serverSocket) {
+        std::cerr << "Failed to set up the reactor test." << std::endl;
+        return 1;
+    }
+    auto& reactor = *reactorResult;
+
+    // Timeouts, and a second concurrent recv() on one socket being refused
+    {
+        auto idleSocket = Listen(Addr("127.0.0.1", 12379));
+        if (!idleSocket) {
+            return 1;
+        }
+        auto idle = AsyncSocket::Attach(*reactor, **idleSocket);
+        if (!idle || AsyncSocket::Attach(*reactor, **idleSocket, 0)) {
+            std::cerr << "AsyncSocket::Attach should accept a socket and reject an empty buffer." << std::endl;
+            return 1;
+        }
+        ErrorCode first = ErrorCode::None;
+        ErrorCode second = ErrorCode::None;
+        const auto before = std::chrono::steady_clock::now();
+        reactor->spawn(recvWithTimeout(*idle, 5'000'000, &first));
+        reactor->spawn(recvWithTimeout(*idle, 5'000'000, &second));
+        if (second != ErrorCode::InvalidArgument || reactor->tasks() != 1 || !reactor->run()) {
+            std::cerr << "A second recv() on a busy socket should fail at once with InvalidArgument." << std::endl;
+            return 1;
+        }
+        if (first != ErrorCode::Timeout || std::chrono::steady_clock::now() - before < std::chrono::milliseconds(5)) {
+            std::cerr << "recv() on an idle socket should time out after its deadline." << std::endl;
+            return 1;
+        }
+    }
+
+    // A pending socket error with nobody waiting must not turn run() into a busy loop, nor be lost
+    {
+        auto refused = Dial(Addr("127.0.0.1", 12381)); // nothing listens there, so the send draws ICMP port unreachable
+        if (!refused) {
+            return 1;
+        }
+        auto async = AsyncSocket::Attach(*reactor, **refused);
+        const uint8_t probe[] = {'?'};
+        if (!async || !(*refused)->send(probe, sizeof(probe))) {
+            std::cerr << "Failed to set up the pending-error reactor test." << std::endl;
+            return 1;
+        }
+        ErrorCode outcome = ErrorCode::None;
+        reactor->spawn(sleepThenRecv(*reactor, *async, &outcome));
+        size_t turns = 0;
+        while (reactor->tasks() != 0) {
+            if (!reactor->runOnce()) {
+                return 1;
+            }
+            ++turns;
+        }
+        if (turns > 10) {
+            std::cerr << "A pending socket error kept the reactor spinning for " << turns << " turns." << std::endl;
+            return 1;
+        }
+        if (outcome == ErrorCode::None || outcome == ErrorCode::Timeout) {
+            std::cerr << "recv() after the refusal should report it, got " << ErrorToString(outcome) << std::endl;
+            return 1;
+        }
+    }
+
+    auto server = AsyncSocket::Attach(*reactor, **serverSocket);
+    if (!server) {
+        return 1;
+    }
+    int echoed = 0;
+    int completed = 0;
+    constexpr uint32_t kClients = 50;
+    reactor->spawn(echoServer(*server, &echoed));
+    for (uint32_t id = 0; id < kClients; ++id) {
+        reactor->spawn(echoClient(*reactor, serverAddr, id, &completed));
+    }
+    if (reactor->tasks() != kClients + 1) {
+        std::cerr << "Every spawned task should be counted until it finishes." << std::endl;
+        return 1;
+    }
+    if (auto ran = reactor->run(); !ran) {
+        std::cerr << "Reactor::run() failed: " << ErrorToString(ran.error()) << std::endl;
+        return 1;
+    }
+    if (completed != static_cast<int>(kClients) || echoed != static_cast<int>(kClients * 3)) {
+        std::cerr << "Coroutine clients completed " << completed << " of " << kClients << ", " << echoed << " echoes." << std::endl;
+        return 1;
+    }
+
+    std::cout << "Reactor ran " << kClients << " coroutine clients through " << echoed << " echoes on one thread." << std::endl;
+    return 0;
+}
 
 int main () {
     using namespace pulse::net::udp;
@@ -39,9 +2096,9 @@ int main () {
         return 1;
     }
 
-    const auto& [recvData, length, addr] = *recvResult;
+    const auto& [recvData, length, addr, rxTimestampNs, drops, truncated, datagramLength] = *recvResult;
     std::string receivedMessage(reinterpret_cast<const char*>(recvData), length);
-    std::cout << "Received message: " << receivedMessage << " from " << addr.ip << ":" << addr.port << std::endl;
+    std::cout << "Received message: " << receivedMessage << " from " << addr.toString() << std::endl;
 
     if (receivedMessage != message) {
         std::cerr << "Received message does not match sent message." << std::endl;
@@ -49,6 +2106,19 @@ int main () {
     }
 
     std::cout << "Received message matches sent message." << std::endl;
+
+    if (testRecvBatch() != 0 || testSendBatch() != 0 || testEndpoint() != 0 || testSendSegmented() != 0 ||
+        testRecvCoalesced() != 0 || testCallerOwnedBuffers() != 0 ||
+        testPacketPool() != 0 || testPoller() != 0 || testListenGroup() != 0 ||
+        testListenSteering() != 0 || testUringBackend() != 0 ||
+        testSocketOptions() != 0 || testRxMetadata() != 0 ||
+        testMetrics() != 0 || testTruncation() != 0 ||
+        testPeerSession() != 0 || testSessionTable() != 0 ||
+        testSendQueue() != 0 || testPacketRing() != 0 || testReceiveDriver() != 0 ||
+        testReactor() != 0) {
+        return 1;
+    }
+
     std::cout << "Test completed successfully." << std::endl;
     return 0;
 }